@@ -0,0 +1,226 @@
+/**
+ * @Description 压缩图像与动画，游程编码加帧间差分，逐帧流式解码到显存或直接写入屏幕
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDAnim.h"
+
+/**
+ * @brief 解码出的一段字节，pdata为NULL时count个字节都是value
+ */
+typedef struct {
+  uint16_t index;        // 在帧中的起始位置
+  uint16_t count;        // 字节数
+  const uint8_t *pdata;  // 原样的字节
+  uint8_t value;         // 重复的字节
+} OLED_AnimSpanTypeDef;
+
+/**
+ * 处理一段需要写入的字节
+ * @param pctx 写入目标的上下文
+ * @param pspan 字节段
+ */
+typedef void (*OLED_AnimSinkTypeDef)(void *pctx, const OLED_AnimSpanTypeDef *pspan);
+
+void OLED_Anim_Init(OLED_AnimDecoderTypeDef *pdec, const OLED_AnimTypeDef *panim)
+{
+  pdec->panim = panim;
+  pdec->offset = 0;
+  pdec->frame = 0;
+}
+
+/**
+ * 检查动画是否能放在屏幕上的指定位置
+ */
+static inline uint8_t OLED_Anim_Fits(const OLED_HandleTypeDef *phandle, const OLED_AnimTypeDef *panim, uint8_t x,
+                                     uint8_t page)
+{
+  return 0 != panim->width && 0 != panim->height && x + panim->width <= phandle->width &&
+         page + (panim->height + 7) / 8 <= phandle->pages;
+}
+
+/**
+ * 解码下一帧，把需要写入的字节段依次交给sink，之后解码器指向下一帧
+ * @param pdec 解码器
+ * @param sink 写入函数
+ * @param pctx 写入函数的上下文
+ * @return 数据损坏时返回OLED_ERROR并回到第0帧
+ */
+static OLED_StatusTypeDef OLED_Anim_Walk(OLED_AnimDecoderTypeDef *pdec, OLED_AnimSinkTypeDef sink, void *pctx)
+{
+  const OLED_AnimTypeDef *panim = pdec->panim;
+  const uint8_t *pdata = panim->pdata;
+  uint32_t offset = pdec->offset, size = panim->size;
+  uint16_t total = panim->width * ((panim->height + 7) / 8);
+  OLED_AnimSpanTypeDef span = {0};
+  if (offset >= size) goto corrupt;
+  uint8_t key = pdata[offset++] & OLED_ANIM_KEY_FRAME;
+  while (span.index < total) {
+    if (offset >= size) goto corrupt;
+    uint8_t token = pdata[offset++];
+    span.count = (token & 0x3f) + 1;
+    span.pdata = NULL;
+    span.value = 0;
+    switch (token & 0xc0) {
+      case OLED_ANIM_LONG_SKIP:
+        if (offset >= size) goto corrupt;
+        span.count = ((token & 0x3f) << 8 | pdata[offset++]) + 1;
+        // fall through
+      case OLED_ANIM_SKIP:
+        if (!key) {
+          if (span.count > total - span.index) goto corrupt;
+          span.index += span.count;
+          continue;
+        }
+        break;  // 关键帧中跳过的字节为0
+      case OLED_ANIM_RUN:
+        if (offset >= size) goto corrupt;
+        span.value = pdata[offset++];
+        break;
+      default:
+        if (span.count > size - offset) goto corrupt;
+        span.pdata = &pdata[offset];
+        offset += span.count;
+        break;
+    }
+    if (span.count > total - span.index) goto corrupt;
+    sink(pctx, &span);
+    span.index += span.count;
+  }
+  if (++pdec->frame >= panim->frames) {
+    pdec->frame = 0;
+    offset = 0;
+  }
+  pdec->offset = offset;
+  return OLED_OK;
+
+corrupt:
+  OLED_Anim_Init(pdec, panim);
+  return OLED_ERROR;
+}
+
+/**
+ * @brief 解码到显存时的上下文
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;
+  uint8_t x;                                  // 动画左上角横坐标
+  uint8_t page;                               // 动画左上角所在的页
+  uint8_t width;                              // 动画宽度
+  uint8_t changed_start[OLED_MAX_PAGE_SIZE];  // 每一页内容改变了的列范围，start > end表示没有改变
+  uint8_t changed_end[OLED_MAX_PAGE_SIZE];
+} OLED_AnimBufferTypeDef;
+
+/**
+ * 把一段字节写入显存，记录改变了的列
+ */
+static void OLED_Anim_Buffer_Sink(void *pctx, const OLED_AnimSpanTypeDef *pspan)
+{
+  OLED_AnimBufferTypeDef *pbuf = (OLED_AnimBufferTypeDef *)pctx;
+  uint8_t row = pspan->index / pbuf->width, column = pspan->index % pbuf->width;
+  uint8_t *pdst = &pbuf->phandle->pbuffer[(pbuf->page + row) * pbuf->phandle->width + pbuf->x];
+  for (uint16_t i = 0; i < pspan->count; ++i) {
+    uint8_t value = NULL == pspan->pdata ? pspan->value : pspan->pdata[i];
+    if (pdst[column] != value) {
+      pdst[column] = value;
+      if (pbuf->changed_start[row] > column) pbuf->changed_start[row] = column;
+      if (pbuf->changed_end[row] < column) pbuf->changed_end[row] = column;
+    }
+    if (++column == pbuf->width) {
+      column = 0;
+      ++row;
+      pdst += pbuf->phandle->width;
+    }
+  }
+}
+
+OLED_StatusTypeDef OLEDH_Anim_Decode(OLED_HandleTypeDef *phandle, OLED_AnimDecoderTypeDef *pdec, uint8_t x,
+                                     uint8_t page)
+{
+  if (!OLED_Anim_Fits(phandle, pdec->panim, x, page)) return OLED_OUT_RANGE;
+  OLED_AnimBufferTypeDef buf = {.phandle = phandle, .x = x, .page = page, .width = pdec->panim->width};
+  uint8_t pages = (pdec->panim->height + 7) / 8;
+  memset(buf.changed_start, 0xff, pages);
+  memset(buf.changed_end, 0, pages);
+  OLED_StatusTypeDef status = OLED_Anim_Walk(pdec, OLED_Anim_Buffer_Sink, &buf);
+  for (uint8_t row = 0; row < pages; ++row) {
+    if (buf.changed_start[row] > buf.changed_end[row]) continue;
+    OLEDH_MARK_DIRTY(phandle, x + buf.changed_start[row], x + buf.changed_end[row], page + row, page + row);
+  }
+  return status;
+}
+
+OLED_StatusTypeDef OLED_Anim_Decode(OLED_AnimDecoderTypeDef *pdec, uint8_t x, uint8_t page)
+{
+  return OLEDH_Anim_Decode(&g_oled_handle, pdec, x, page);
+}
+
+#ifndef OLED_USING_DMA_TRANSMIT
+/**
+ * @brief 直接写入屏幕时的上下文，把连续的字节攒在栈上的缓存里一起发送
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;
+  uint8_t x;                            // 动画左上角横坐标
+  uint8_t page;                         // 动画左上角所在的页
+  uint8_t width;                        // 动画宽度
+  uint8_t addressed;                    // 缓存中的字节已经寻址，接着上一次写入的位置继续写
+  uint16_t start;                       // 缓存中第一个字节在帧中的位置
+  uint16_t length;                      // 缓存中的字节数
+  OLED_StatusTypeDef status;            // 第一个错误
+  uint8_t data[OLED_ANIM_SPAN_LENGTH];  // 缓存
+} OLED_AnimStreamTypeDef;
+
+/**
+ * 发送缓存中的字节，一段连续的字节只在第一次发送前寻址
+ */
+static void OLED_Anim_Stream_Flush(OLED_AnimStreamTypeDef *pstream)
+{
+  if (0 == pstream->length) return;
+  if (OLED_OK == pstream->status && !pstream->addressed) {
+    uint8_t row = pstream->start / pstream->width, column = pstream->start % pstream->width;
+    // 窗口的右边界是动画的右边界，一段字节不会跨页
+    pstream->status = OLEDH_Set_Window(pstream->phandle, pstream->x + column, pstream->x + pstream->width - 1,
+                                       pstream->page + row, pstream->page + row);
+  }
+  if (OLED_OK == pstream->status) pstream->status = OLEDH_Write_Data(pstream->phandle, pstream->data, pstream->length);
+  pstream->addressed = 1;
+  pstream->start += pstream->length;
+  pstream->length = 0;
+}
+
+/**
+ * 把一段字节追加到缓存，与缓存中的字节不连续或换页时先发送缓存
+ */
+static void OLED_Anim_Stream_Sink(void *pctx, const OLED_AnimSpanTypeDef *pspan)
+{
+  OLED_AnimStreamTypeDef *pstream = (OLED_AnimStreamTypeDef *)pctx;
+  uint16_t index = pspan->index;
+  for (uint16_t i = 0; i < pspan->count; ++i, ++index) {
+    if (0 != pstream->length && (pstream->start + pstream->length != index || 0 == index % pstream->width)) {
+      OLED_Anim_Stream_Flush(pstream);
+      pstream->addressed = 0;  // 不连续或换页，重新寻址
+    } else if (OLED_ANIM_SPAN_LENGTH == pstream->length) {
+      OLED_Anim_Stream_Flush(pstream);  // 缓存满了，接着写入不需要寻址
+    }
+    if (0 == pstream->length && !pstream->addressed) pstream->start = index;
+    pstream->data[pstream->length++] = NULL == pspan->pdata ? pspan->value : pspan->pdata[i];
+  }
+}
+
+OLED_StatusTypeDef OLEDH_Anim_Stream(OLED_HandleTypeDef *phandle, OLED_AnimDecoderTypeDef *pdec, uint8_t x,
+                                     uint8_t page)
+{
+  if (!OLED_Anim_Fits(phandle, pdec->panim, x, page)) return OLED_OUT_RANGE;
+  OLED_AnimStreamTypeDef stream = {.phandle = phandle, .x = x, .page = page, .width = pdec->panim->width};
+  OLED_StatusTypeDef status = OLED_Anim_Walk(pdec, OLED_Anim_Stream_Sink, &stream);
+  OLED_Anim_Stream_Flush(&stream);
+  return OLED_OK != status ? status : stream.status;
+}
+
+OLED_StatusTypeDef OLED_Anim_Stream(OLED_AnimDecoderTypeDef *pdec, uint8_t x, uint8_t page)
+{
+  return OLEDH_Anim_Stream(&g_oled_handle, pdec, x, page);
+}
+#endif
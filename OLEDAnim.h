@@ -0,0 +1,94 @@
+/**
+ * @Description 压缩图像与动画，游程编码加帧间差分，逐帧流式解码到显存或直接写入屏幕
+ * @note 数据由tools/oled_animgen.py生成，解码时直接从Flash中顺序读取，不需要额外的缓存
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDANIM_H
+#define OLEDANIM_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+#ifndef OLED_ANIM_SPAN_LENGTH
+#  define OLED_ANIM_SPAN_LENGTH 64  // 直接写入屏幕时栈上暂存的字节数，攒满后发送一次
+#endif
+
+/**
+ * @brief 每一帧开头的标志字节
+ */
+#define OLED_ANIM_KEY_FRAME 0x01U  // 关键帧，跳过的字节写0；否则为差分帧，跳过的字节保持上一帧的内容
+
+/**
+ * @brief 帧数据的记号，按页存储的一帧(每页width个字节，低位在上)从第0个字节开始依次覆盖
+ */
+#define OLED_ANIM_SKIP 0x00U       // 0x00~0x3f: 跳过(低6位 + 1)个字节
+#define OLED_ANIM_RUN 0x40U        // 0x40~0x7f: 后跟1个字节，重复(低6位 + 1)次
+#define OLED_ANIM_LITERAL 0x80U    // 0x80~0xbf: 后跟(低6位 + 1)个原样的字节
+#define OLED_ANIM_LONG_SKIP 0xc0U  // 0xc0~0xff: 后跟1个字节，跳过((低6位 << 8 | 该字节) + 1)个字节
+
+/**
+ * @brief 压缩的图像或动画，图像就是只有一帧的动画
+ * @note 第0帧必须是关键帧，播放到最后一帧后回到第0帧
+ */
+typedef struct {
+  const uint8_t *pdata;  // 压缩数据
+  uint32_t size;         // 压缩数据的字节数
+  uint8_t width;         // 宽度
+  uint8_t height;        // 高度，按页向上取整后整页写入
+  uint16_t frames;       // 帧数
+} OLED_AnimTypeDef;
+
+/**
+ * @brief 解码器，记录下一帧在压缩数据中的位置
+ */
+typedef struct {
+  const OLED_AnimTypeDef *panim;  // 正在播放的动画
+  uint32_t offset;                // 下一帧的起始位置
+  uint16_t frame;                 // 下一帧的帧号
+} OLED_AnimDecoderTypeDef;
+
+/**
+ * 初始化解码器，从第0帧开始
+ * @param pdec 解码器
+ * @param panim 动画
+ */
+void OLED_Anim_Init(OLED_AnimDecoderTypeDef *pdec, const OLED_AnimTypeDef *panim);
+
+/**
+ * 把下一帧解码到g_oled_buffer，只标记内容真正改变了的列
+ * @note 差分帧建立在上一帧之上，两帧之间不能在动画区域内绘制其它内容
+ * @param pdec 解码器
+ * @param x 左上角横坐标
+ * @param page 左上角所在的页
+ * @return 超出屏幕时返回OLED_OUT_RANGE，数据损坏时返回OLED_ERROR并回到第0帧
+ */
+OLED_StatusTypeDef OLED_Anim_Decode(OLED_AnimDecoderTypeDef *pdec, uint8_t x, uint8_t page);
+
+#ifndef OLED_USING_DMA_TRANSMIT
+/**
+ * 把下一帧中改变的字节直接写入屏幕，不经过g_oled_buffer，适合显存放不下的场合
+ * @note 每段连续改变的字节只寻址一次，需要阻塞的传输函数
+ * @note g_oled_buffer中对应的区域不会更新，之后整屏刷新或刷新到这一区域时会覆盖动画
+ * @param pdec 解码器
+ * @param x 左上角横坐标
+ * @param page 左上角所在的页
+ * @return 超出屏幕时返回OLED_OUT_RANGE，数据损坏时返回OLED_ERROR并回到第0帧
+ */
+OLED_StatusTypeDef OLED_Anim_Stream(OLED_AnimDecoderTypeDef *pdec, uint8_t x, uint8_t page);
+#endif
+
+OLED_StatusTypeDef OLEDH_Anim_Decode(OLED_HandleTypeDef *phandle, OLED_AnimDecoderTypeDef *pdec, uint8_t x,
+                                     uint8_t page);
+#ifndef OLED_USING_DMA_TRANSMIT
+OLED_StatusTypeDef OLEDH_Anim_Stream(OLED_HandleTypeDef *phandle, OLED_AnimDecoderTypeDef *pdec, uint8_t x,
+                                     uint8_t page);
+#endif
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDANIM_H
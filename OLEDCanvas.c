@@ -0,0 +1,178 @@
+/**
+ * @Description 比屏幕大的虚拟画布，屏幕显示其中一个视口，移动视口时直接从画布发送可见部分，不拷贝到显存
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDCanvas.h"
+
+/**
+ * 取得一个分块的存储
+ */
+#define OLED_CANVAS_TILE(pcanvas, tile) \
+  (&(pcanvas)->pbuffer[(uint32_t)(tile) * (pcanvas)->tile_width * (pcanvas)->tile_pages])
+
+OLED_StatusTypeDef OLED_Canvas_Init(OLED_CanvasTypeDef *pcanvas, OLED_HandleTypeDef *phandle, uint8_t *pbuffer,
+                                    uint16_t width, uint16_t height, uint8_t tile_width, uint8_t tile_height,
+                                    OLED_CanvasDrawTypeDef render)
+{
+  memset(pcanvas, 0, sizeof(OLED_CanvasTypeDef));
+  if (NULL == phandle) phandle = &g_oled_handle;
+  if (NULL == pbuffer || 0 == tile_width || 0 == tile_height || 0 != tile_height % 8 ||
+      tile_height / 8 > OLED_MAX_PAGE_SIZE || 0 != width % tile_width || 0 != height % tile_height ||
+      width < phandle->width || height < phandle->pages * 8)
+    return OLED_ERROR;
+  if ((uint32_t)(width / tile_width) * (height / tile_height) > OLED_CANVAS_MAX_TILES) return OLED_ERROR;
+  pcanvas->phandle = phandle;
+  pcanvas->pbuffer = pbuffer;
+  pcanvas->width = width;
+  pcanvas->height = height;
+  pcanvas->tile_width = tile_width;
+  pcanvas->tile_pages = tile_height / 8;
+  pcanvas->tiles_x = width / tile_width;
+  pcanvas->tiles_y = height / tile_height;
+  pcanvas->render = render;
+  // 没有绘制回调时分块的内容全部由用户绘制，不能在进入视口时清空
+  if (NULL == render) pcanvas->valid = 0xffffffffUL;
+  pcanvas->changed = 1;
+  memset(pbuffer, 0, OLED_CANVAS_BUFFER_SIZE(width, height));
+  return OLED_OK;
+}
+
+void OLED_Canvas_Get_Tile(const OLED_CanvasTypeDef *pcanvas, uint8_t tile, OLED_HandleTypeDef *ptile_handle)
+{
+  memset(ptile_handle, 0, sizeof(OLED_HandleTypeDef));
+  ptile_handle->pbuffer = OLED_CANVAS_TILE(pcanvas, tile);
+  ptile_handle->width = pcanvas->tile_width;
+  ptile_handle->height = pcanvas->tile_pages * 8;
+  ptile_handle->pages = pcanvas->tile_pages;
+}
+
+/**
+ * 找出与一块区域相交的分块
+ * @param pcanvas 画布
+ * @return 分块的位图，第n位对应第n个分块
+ */
+static uint32_t OLED_Canvas_Tiles(const OLED_CanvasTypeDef *pcanvas, int32_t x, int32_t y, int32_t width,
+                                  int32_t height)
+{
+  int32_t x_end = x + width - 1, y_end = y + height - 1;
+  uint32_t mask = 0;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x_end >= pcanvas->width) x_end = pcanvas->width - 1;
+  if (y_end >= pcanvas->height) y_end = pcanvas->height - 1;
+  if (width <= 0 || height <= 0 || x > x_end || y > y_end) return 0;
+  uint8_t tile_height = pcanvas->tile_pages * 8;
+  for (uint8_t row = y / tile_height; row <= y_end / tile_height; ++row)
+    for (uint8_t column = x / pcanvas->tile_width; column <= x_end / pcanvas->tile_width; ++column)
+      mask |= 1UL << (row * pcanvas->tiles_x + column);
+  return mask;
+}
+
+/**
+ * 一块区域是否与视口相交
+ * @param pcanvas 画布
+ * @return 相交时返回1
+ */
+static uint8_t OLED_Canvas_In_View(const OLED_CanvasTypeDef *pcanvas, int32_t x, int32_t y, int32_t width,
+                                   int32_t height)
+{
+  const OLED_HandleTypeDef *phandle = pcanvas->phandle;
+  return width > 0 && height > 0 && x < pcanvas->view_x + phandle->width && x + width > pcanvas->view_x &&
+         y < pcanvas->view_y + phandle->pages * 8 && y + height > pcanvas->view_y;
+}
+
+/**
+ * 清空一个分块并调用绘制回调画出它的全部内容
+ * @param pcanvas 画布
+ * @param tile 分块序号
+ */
+static void OLED_Canvas_Render_Tile(OLED_CanvasTypeDef *pcanvas, uint8_t tile)
+{
+  OLED_HandleTypeDef tile_handle;
+  OLED_Canvas_Get_Tile(pcanvas, tile, &tile_handle);
+  memset(tile_handle.pbuffer, 0, pcanvas->tile_width * pcanvas->tile_pages);
+  pcanvas->render(pcanvas, &tile_handle, tile % pcanvas->tiles_x * pcanvas->tile_width,
+                  tile / pcanvas->tiles_x * pcanvas->tile_pages * 8);
+  pcanvas->valid |= 1UL << tile;
+  pcanvas->stats.renders++;
+}
+
+void OLED_Canvas_Draw(OLED_CanvasTypeDef *pcanvas, int16_t x, int16_t y, int16_t width, int16_t height,
+                      OLED_CanvasDrawTypeDef draw)
+{
+  OLED_HandleTypeDef tile_handle;
+  uint32_t mask = OLED_Canvas_Tiles(pcanvas, x, y, width, height) & pcanvas->valid;
+  for (uint8_t tile = 0; 0 != mask; ++tile, mask >>= 1) {
+    if (!(mask & 1U)) continue;
+    OLED_Canvas_Get_Tile(pcanvas, tile, &tile_handle);
+    draw(pcanvas, &tile_handle, tile % pcanvas->tiles_x * pcanvas->tile_width,
+         tile / pcanvas->tiles_x * pcanvas->tile_pages * 8);
+  }
+  OLED_Canvas_Touch(pcanvas, x, y, width, height);
+}
+
+void OLED_Canvas_Touch(OLED_CanvasTypeDef *pcanvas, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+  if (OLED_Canvas_In_View(pcanvas, x, y, width, height)) pcanvas->changed = 1;
+}
+
+void OLED_Canvas_Invalidate(OLED_CanvasTypeDef *pcanvas, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+  if (NULL == pcanvas->render) return;
+  pcanvas->valid &= ~OLED_Canvas_Tiles(pcanvas, x, y, width, height);
+  OLED_Canvas_Touch(pcanvas, x, y, width, height);
+}
+
+void OLED_Canvas_Set_Viewport(OLED_CanvasTypeDef *pcanvas, int32_t x, int32_t y)
+{
+  int32_t x_max = pcanvas->width - pcanvas->phandle->width;
+  int32_t y_max = pcanvas->height - pcanvas->phandle->pages * 8;
+  x = x < 0 ? 0 : x > x_max ? x_max : x;
+  y = y < 0 ? 0 : y > y_max ? y_max : y;
+  y &= ~7;
+  if (x == pcanvas->view_x && y == pcanvas->view_y) return;
+  pcanvas->view_x = x;
+  pcanvas->view_y = y;
+  pcanvas->changed = 1;
+}
+
+void OLED_Canvas_Pan(OLED_CanvasTypeDef *pcanvas, int32_t dx, int32_t dy)
+{
+  OLED_Canvas_Set_Viewport(pcanvas, pcanvas->view_x + dx, pcanvas->view_y + dy);
+}
+
+OLED_StatusTypeDef OLED_Canvas_Show(OLED_CanvasTypeDef *pcanvas)
+{
+  OLED_HandleTypeDef *phandle = pcanvas->phandle;
+  OLED_StatusTypeDef status = OLED_OK;
+  if (!pcanvas->changed) {
+    pcanvas->stats.skipped++;
+    return OLED_OK;
+  }
+  uint32_t missing = OLED_Canvas_Tiles(pcanvas, pcanvas->view_x, pcanvas->view_y, phandle->width, phandle->pages * 8);
+  missing &= ~pcanvas->valid;
+  for (uint8_t tile = 0; 0 != missing; ++tile, missing >>= 1)
+    if (missing & 1U) OLED_Canvas_Render_Tile(pcanvas, tile);
+
+  uint16_t tile_size = pcanvas->tile_width * pcanvas->tile_pages;
+  uint16_t view_end = pcanvas->view_x + phandle->width;
+  for (uint8_t page = 0; OLED_OK == status && page < phandle->pages; ++page) {
+    uint16_t canvas_page = pcanvas->view_y / 8 + page;
+    // 这一页在所在分块行中第一个分块里的起始位置，同一行的分块相隔tile_size字节
+    uint8_t *prow = OLED_CANVAS_TILE(pcanvas, canvas_page / pcanvas->tile_pages * pcanvas->tiles_x) +
+                    canvas_page % pcanvas->tile_pages * pcanvas->tile_width;
+    status = OLEDH_Set_Window(phandle, 0, phandle->width - 1, page, page);
+    for (uint16_t x = pcanvas->view_x, next; OLED_OK == status && x < view_end; x = next) {
+      uint8_t column = x % pcanvas->tile_width;
+      next = x - column + pcanvas->tile_width;  // 下一个分块的起始列
+      if (next > view_end) next = view_end;
+      status = OLEDH_Write_Data(phandle, prow + x / pcanvas->tile_width * tile_size + column, next - x);
+    }
+  }
+  OLEDH_MARK_ALL_DIRTY(phandle);  // 屏幕上显示的是画布，与显存、影子帧都对不上
+  pcanvas->stats.shows++;
+  if (OLED_OK == status) pcanvas->changed = 0;
+  return status;
+}
@@ -0,0 +1,156 @@
+/**
+ * @Description 比屏幕大的虚拟画布，屏幕显示其中一个视口，移动视口时直接从画布发送可见部分，不拷贝到显存
+ * @note 画布分成若干分块，每块的格式与显存相同，所有绘图函数都可以通过分块的实例直接在画布上绘制
+ * @note 分块第一次进入视口时才调用绘制回调，滚动长列表时只绘制新露出的分块
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDCANVAS_H
+#define OLEDCANVAS_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+#define OLED_CANVAS_MAX_TILES 32  // 一块画布最多的分块数
+
+/**
+ * @brief 画布存储需要的字节数，height为8的倍数
+ */
+#define OLED_CANVAS_BUFFER_SIZE(width, height) ((uint32_t)(width) * ((height) / 8))
+
+typedef struct OLED_CanvasTypeDef OLED_CanvasTypeDef;
+
+/**
+ * 在一个分块上绘制画布的内容
+ * @note 分块的实例只用于绘制，坐标以分块左上角为原点，画布坐标(cx, cy)在分块中为(cx - x, cy - y)，超出分块的部分被裁剪
+ * @param pcanvas 画布
+ * @param ptile 分块的实例
+ * @param x 分块左上角在画布中的横坐标
+ * @param y 分块左上角在画布中的纵坐标
+ */
+typedef void (*OLED_CanvasDrawTypeDef)(OLED_CanvasTypeDef *pcanvas, OLED_HandleTypeDef *ptile, int16_t x, int16_t y);
+
+/**
+ * @brief 画布的统计
+ */
+typedef struct {
+  uint32_t shows;    // 发送视口的次数
+  uint32_t skipped;  // 视口没有移动、内容没有变化而跳过发送的次数
+  uint32_t renders;  // 调用绘制回调的分块数
+} OLED_CanvasStatsTypeDef;
+
+/**
+ * @brief 虚拟画布，由用户分配
+ * @note 存储按分块依次存放，先行后列，每块tile_width * tile_pages字节，块内与显存一样按页存储
+ */
+struct OLED_CanvasTypeDef {
+  OLED_HandleTypeDef *phandle;    // 显示的屏幕实例
+  uint8_t *pbuffer;               // 画布存储，大小为OLED_CANVAS_BUFFER_SIZE(width, height)
+  uint16_t width;                 // 画布宽度，不小于屏幕宽度
+  uint16_t height;                // 画布高度，不小于屏幕高度
+  uint8_t tile_width;             // 分块宽度
+  uint8_t tile_pages;             // 分块页数，不超过OLED_MAX_PAGE_SIZE
+  uint8_t tiles_x;                // 每行的分块数
+  uint8_t tiles_y;                // 每列的分块数
+  uint32_t valid;                 // 已经绘制过的分块
+  OLED_CanvasDrawTypeDef render;  // 分块第一次进入视口时绘制它的全部内容，可为NULL
+  void *puser;                    // 用户数据，初始化之后填写，驱动不使用
+  uint16_t view_x;                // 视口左上角在画布中的横坐标
+  uint16_t view_y;                // 视口左上角在画布中的纵坐标，8的倍数
+  uint8_t changed;                // 视口移动过或者其中的内容变化过，需要重新发送
+  OLED_CanvasStatsTypeDef stats;  // 统计
+};
+
+/**
+ * 初始化画布，视口在左上角，所有分块等待第一次进入视口时绘制
+ * @note 画布使用屏幕的原始方向，OLED_ROTATION为90/270时绘图函数在每个分块内各自旋转，不适合使用画布
+ * @param pcanvas 画布
+ * @param phandle 屏幕实例，为NULL时使用默认实例
+ * @param pbuffer 画布存储
+ * @param width 画布宽度，tile_width的倍数
+ * @param height 画布高度，tile_height的倍数
+ * @param tile_width 分块宽度
+ * @param tile_height 分块高度，8的倍数
+ * @param render 分块的绘制回调，可为NULL，此时分块保持清空，由用户自行绘制
+ * @return 尺寸不满足上述要求、小于屏幕或分块超过OLED_CANVAS_MAX_TILES时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Canvas_Init(OLED_CanvasTypeDef *pcanvas, OLED_HandleTypeDef *phandle, uint8_t *pbuffer,
+                                    uint16_t width, uint16_t height, uint8_t tile_width, uint8_t tile_height,
+                                    OLED_CanvasDrawTypeDef render);
+
+/**
+ * 取得一个分块的实例，可以用OLEDGraphics.h、OLEDFont.h等所有绘图函数直接在分块上绘制
+ * @note 直接这样绘制之后需要调用OLED_Canvas_Touch
+ * @param pcanvas 画布
+ * @param tile 分块序号，先行后列
+ * @param ptile_handle 输出的实例，只用于绘制，不能刷新
+ */
+void OLED_Canvas_Get_Tile(const OLED_CanvasTypeDef *pcanvas, uint8_t tile, OLED_HandleTypeDef *ptile_handle);
+
+/**
+ * 在画布的一块区域上绘制，对每个与区域相交并且已经绘制过的分块调用一次draw
+ * @note 还没有绘制过的分块跳过，进入视口时由render绘制，所以render需要能画出包括这次改动在内的全部内容
+ * @param pcanvas 画布
+ * @param x 区域左上角横坐标
+ * @param y 区域左上角纵坐标
+ * @param width 区域宽度
+ * @param height 区域高度
+ * @param draw 绘制函数
+ */
+void OLED_Canvas_Draw(OLED_CanvasTypeDef *pcanvas, int16_t x, int16_t y, int16_t width, int16_t height,
+                      OLED_CanvasDrawTypeDef draw);
+
+/**
+ * 标记画布的一块区域被直接修改过，与视口相交时下一次OLED_Canvas_Show重新发送
+ * @param pcanvas 画布
+ * @param x 区域左上角横坐标
+ * @param y 区域左上角纵坐标
+ * @param width 区域宽度
+ * @param height 区域高度
+ */
+void OLED_Canvas_Touch(OLED_CanvasTypeDef *pcanvas, int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * 让一块区域的分块失效，进入视口时重新调用render绘制，例如列表的数据整个变化之后
+ * @param pcanvas 画布
+ * @param x 区域左上角横坐标
+ * @param y 区域左上角纵坐标
+ * @param width 区域宽度
+ * @param height 区域高度
+ */
+void OLED_Canvas_Invalidate(OLED_CanvasTypeDef *pcanvas, int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * 移动视口，只记录位置，不发送
+ * @note 视口超出画布时停在边缘
+ * @param pcanvas 画布
+ * @param x 视口左上角横坐标，任意列
+ * @param y 视口左上角纵坐标，向下取整到8的倍数，GDDRAM按页写入，不按页对齐时需要拼接相邻两页
+ */
+void OLED_Canvas_Set_Viewport(OLED_CanvasTypeDef *pcanvas, int32_t x, int32_t y);
+
+/**
+ * 相对当前位置移动视口
+ * @param pcanvas 画布
+ * @param dx 横向移动的列数
+ * @param dy 纵向移动的行数，8的倍数
+ */
+void OLED_Canvas_Pan(OLED_CanvasTypeDef *pcanvas, int32_t dx, int32_t dy);
+
+/**
+ * 把视口发送到屏幕，视口内还没有绘制过的分块先调用render绘制
+ * @note 每一页寻址一次，数据直接取自画布的分块，一页跨过几个分块就分几次发送，不经过显存
+ * @note 发送后屏幕与实例的显存不一致，之后再用OLED_Refresh_GSRAM刷新时整屏发送
+ * @note 使用OLEDH_Write_Data发送，只适用于阻塞的传输函数
+ * @param pcanvas 画布
+ * @return 视口没有移动、内容没有变化时直接返回OLED_OK
+ */
+OLED_StatusTypeDef OLED_Canvas_Show(OLED_CanvasTypeDef *pcanvas);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDCANVAS_H
@@ -0,0 +1,114 @@
+/**
+ * @Description OLED控制器描述表，同一份固件可以在运行时为每块屏幕选择不同的芯片
+ * @Author jinming xi
+ * @Date 2022/11/5
+ * @Project OLEDDriver
+ */
+#include "OLEDDriver.h"
+
+#define CALC_NUM_LENGTH(x) sizeof(x) / sizeof(uint8_t)
+
+static const uint8_t __ssd1306_init_param[] = {0xae,         // 关闭显示屏
+                                               0xa4,         // 全局显示开启,0xa4正常,0xa5无视GRAM内容点亮全屏
+                                               0xa6,         // 0xa7反色显示
+                                               0xb0,         // 设置起始页地址，只对页寻址模式有效
+                                               0x40,         // Set display RAM display start line register from 0~63
+                                               0xd5, 0x80,   // 设置时钟分频因子，振荡频率
+                                               0x81, 0x7f,   // 设置对比度
+                                               0x8d, 0x14,   // 打开电荷泵
+                                               0x00, 0x10,   // 设置起始列地址和终止列地址
+                                               0xd3, 0x00,   // 设置垂直偏移地址
+                                               0xd9, 0x22,   // Set Pre-Charge Period
+                                               0xdb, 0x10};  // Set V COMH Deselect Level
+static const uint8_t __ssd1306_on_param[] = {0x8d, 0x14, 0xaf};
+static const uint8_t __ssd1306_off_param[] = {0x8d, 0x10, 0xae};
+
+static const uint8_t __sh1106_init_param[] = {0xae,         // 关闭显示屏
+                                              0xa4,         // 全局显示开启,0xa4正常,0xa5无视GRAM内容点亮全屏
+                                              0xa6,         // 0xa7反色显示
+                                              0xb0,         // 设置起始页地址
+                                              0x40,         // Set display RAM display start line register from 0~63
+                                              0xd5, 0x80,   // 设置时钟分频因子，振荡频率
+                                              0x81, 0x7f,   // 设置对比度
+                                              0xad, 0x8b,   // 打开DC-DC，SH1106没有0x8d电荷泵命令
+                                              0x02, 0x10,   // 起始列地址，132列中居中的128列从第2列开始
+                                              0xd3, 0x00,   // 设置垂直偏移地址
+                                              0xd9, 0x22,   // Set Pre-Charge Period
+                                              0xdb, 0x10};  // Set V COMH Deselect Level
+static const uint8_t __sh1106_on_param[] = {0xad, 0x8b, 0xaf};
+static const uint8_t __sh1106_off_param[] = {0xad, 0x8a, 0xae};
+
+static const uint8_t __ssd1309_init_param[] = {0xae,         // 关闭显示屏
+                                               0xa4,         // 全局显示开启,0xa4正常,0xa5无视GRAM内容点亮全屏
+                                               0xa6,         // 0xa7反色显示
+                                               0xb0,         // 设置起始页地址，只对页寻址模式有效
+                                               0x40,         // Set display RAM display start line register from 0~63
+                                               0xd5, 0xa0,   // 设置时钟分频因子，振荡频率
+                                               0x81, 0xdf,   // 设置对比度
+                                               0x00, 0x10,   // 设置起始列地址和终止列地址
+                                               0xd3, 0x00,   // 设置垂直偏移地址
+                                               0xd9, 0x82,   // Set Pre-Charge Period
+                                               0xdb, 0x34};  // Set V COMH Deselect Level
+static const uint8_t __ssd1309_on_param[] = {0xaf};  // SSD1309由外部提供VCC，没有电荷泵需要开关
+static const uint8_t __ssd1309_off_param[] = {0xae};
+
+const OLED_ControllerTypeDef g_oled_ssd1306 = {
+    .name = "SSD1306",
+    .pinit = __ssd1306_init_param,
+    .init_length = CALC_NUM_LENGTH(__ssd1306_init_param),
+    .pon = __ssd1306_on_param,
+    .on_length = CALC_NUM_LENGTH(__ssd1306_on_param),
+    .poff = __ssd1306_off_param,
+    .off_length = CALC_NUM_LENGTH(__ssd1306_off_param),
+    .ram_width = 128,
+    .column_offset = 0,
+    .horizontal = 1,
+    .continuous_scroll = OLED_SCROLL_SSD1306,
+    .max_transfer = 0,
+};
+
+const OLED_ControllerTypeDef g_oled_sh1106 = {
+    .name = "SH1106",
+    .pinit = __sh1106_init_param,
+    .init_length = CALC_NUM_LENGTH(__sh1106_init_param),
+    .pon = __sh1106_on_param,
+    .on_length = CALC_NUM_LENGTH(__sh1106_on_param),
+    .poff = __sh1106_off_param,
+    .off_length = CALC_NUM_LENGTH(__sh1106_off_param),
+    .ram_width = 132,
+    .column_offset = 2,
+    .horizontal = 0,
+    .continuous_scroll = OLED_SCROLL_NONE,
+    .max_transfer = 0,
+};
+
+const OLED_ControllerTypeDef g_oled_ssd1309 = {
+    .name = "SSD1309",
+    .pinit = __ssd1309_init_param,
+    .init_length = CALC_NUM_LENGTH(__ssd1309_init_param),
+    .pon = __ssd1309_on_param,
+    .on_length = CALC_NUM_LENGTH(__ssd1309_on_param),
+    .poff = __ssd1309_off_param,
+    .off_length = CALC_NUM_LENGTH(__ssd1309_off_param),
+    .ram_width = 128,
+    .column_offset = 0,
+    .horizontal = 1,
+    .continuous_scroll = OLED_SCROLL_SSD1309,
+    .max_transfer = 0,
+};
+
+// SSD1315的命令集与SSD1306兼容，共用初始化表
+const OLED_ControllerTypeDef g_oled_ssd1315 = {
+    .name = "SSD1315",
+    .pinit = __ssd1306_init_param,
+    .init_length = CALC_NUM_LENGTH(__ssd1306_init_param),
+    .pon = __ssd1306_on_param,
+    .on_length = CALC_NUM_LENGTH(__ssd1306_on_param),
+    .poff = __ssd1306_off_param,
+    .off_length = CALC_NUM_LENGTH(__ssd1306_off_param),
+    .ram_width = 128,
+    .column_offset = 0,
+    .horizontal = 1,
+    .continuous_scroll = OLED_SCROLL_SSD1306,
+    .max_transfer = 0,
+};
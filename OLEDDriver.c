@@ -6,49 +6,1042 @@
  */
 #include "OLEDDriver.h"
 #include "OLEDDriverParam.h"
+#include "OLEDFont.h"
+#include "OLEDGraphics.h"
 #include "codetable.h"
 
 #define CALC_NUM_LENGTH(x) sizeof(x) / sizeof(uint8_t)
 
 /**
- * OLED 写命令函数，作用于仅限于本文件
- * @param pcmd 命令数组指针
- * @param total 命令长度
+ * @breif 默认实例使用的缓存
+ * @parm g_oled_buffer作为图形缓存
+ */
+#ifndef OLED_USING_STRIP_RENDER
+uint8_t g_oled_buffer[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+#  ifdef OLED_USING_SHADOW_REFRESH
+/**
+ * @brief 影子帧，保存最后一次实际发送到屏幕的内容
+ */
+uint8_t g_oled_shadow_buffer[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+#  elif defined(OLED_USING_DMA_TRANSMIT)
+/**
+ * @brief 未使用影子帧时，发送前把改动区域拷贝到g_oled_tx_buffer，发送期间可以继续绘制下一帧
+ */
+uint8_t g_oled_tx_buffer[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+#  endif
+#endif
+
+static OLED_StatusTypeDef OLED_Default_Transmit(OLED_HandleTypeDef *phandle, uint8_t *pData, uint16_t Size,
+                                                uint8_t mode)
+{
+  return OLED_Transmit(phandle->address, mode ? 0x40 : 0x00, pData, Size, mode);
+}
+
+static void OLED_Default_Before(OLED_HandleTypeDef *phandle, uint8_t mode)
+{
+  UNUSED(phandle);
+  if (mode)
+    OLED_Refresh_GSRAM_CallBefore();
+  else
+    OLED_WriteCmd_CallBefore();
+}
+
+static void OLED_Default_After(OLED_HandleTypeDef *phandle, uint8_t mode)
+{
+  UNUSED(phandle);
+  if (mode)
+    OLED_Refresh_GSRAM_CallAfter();
+  else
+    OLED_WriteCmd_CallAfter();
+}
+
+#ifdef OLED_USING_DMA_TRANSMIT
+static void OLED_Default_Complete(OLED_HandleTypeDef *phandle)
+{
+  UNUSED(phandle);
+  OLED_Refresh_Async_CallComplete();
+}
+#endif
+
+const OLED_TransportTypeDef g_oled_default_transport = {
+    .transmit = OLED_Default_Transmit,
+    .before = OLED_Default_Before,
+    .after = OLED_Default_After,
+#ifdef OLED_USING_DMA_TRANSMIT
+    .complete = OLED_Default_Complete,
+#endif
+};
+
+OLED_HandleTypeDef g_oled_handle = {
+#ifndef OLED_USING_STRIP_RENDER
+    .pbuffer = g_oled_buffer[0],
+#endif
+    .width = OLED_PIX_WIDTH,
+    .height = OLED_PIX_HEIGHT,
+    .column_offset = OLED_COLUMN_OFFSET,
+    .com_pins = OLED_COM_PINS,
+    .address = OLED_PHY_ADDRESS,
+    .ptransport = &g_oled_default_transport,
+    .pcontroller = &OLED_DEFAULT_CONTROLLER,
+#ifndef OLED_USING_STRIP_RENDER
+#  ifdef OLED_USING_SHADOW_REFRESH
+    .pshadow = g_oled_shadow_buffer[0],
+#  elif defined(OLED_USING_DMA_TRANSMIT)
+    .ptx = g_oled_tx_buffer[0],
+#  endif
+#endif
+    .pages = OLED_PAGE_SIZE,
+#ifdef OLED_USING_PARTIAL_REFRESH
+    .refresh_all = 1,  // 上电后屏幕内容未知，第一次刷新整屏推送
+#endif
+};
+
+/**
+ * 取得一页中某一列的地址
+ */
+#define OLED_PIXEL_ROW(phandle, page) (&(phandle)->pbuffer[(uint16_t)(page) * (phandle)->width])
+
+/**
+ * 调用传输前后的钩子函数
+ */
+#define OLED_TRANSPORT_BEFORE(phandle, mode) \
+  if (NULL != (phandle)->ptransport->before) (phandle)->ptransport->before(phandle, mode)
+#define OLED_TRANSPORT_AFTER(phandle, mode) \
+  if (NULL != (phandle)->ptransport->after) (phandle)->ptransport->after(phandle, mode)
+
+/**
+ * 性能统计，定义OLED_USING_TRACE且实例挂有ptrace时记录
+ * @note OLED_TRACE_TRANSFER_BEGIN/END包住每一次传输，按mode计入命令或数据
+ */
+#ifdef OLED_USING_TRACE
+#  define OLED_TRACE_BEGIN(phandle, op) \
+    if (NULL != (phandle)->ptrace) OLED_Trace_Begin((phandle)->ptrace, op)
+#  define OLED_TRACE_END(phandle, op, status) \
+    if (NULL != (phandle)->ptrace) OLED_Trace_End((phandle)->ptrace, op, OLED_OK != (status))
+#  define OLED_TRACE_TRANSFER_OP(mode) ((mode) ? OLED_TRACE_DATA_TRANSFER : OLED_TRACE_CMD_TRANSFER)
+#  define OLED_TRACE_TRANSFER_BEGIN(phandle, mode, size)                 \
+    if (NULL != (phandle)->ptrace) {                                     \
+      OLED_Trace_Bytes((phandle)->ptrace, mode, size);                   \
+      OLED_Trace_Begin((phandle)->ptrace, OLED_TRACE_TRANSFER_OP(mode)); \
+    }
+#  define OLED_TRACE_TRANSFER_END(phandle, mode, status) OLED_TRACE_END(phandle, OLED_TRACE_TRANSFER_OP(mode), status)
+#  ifdef OLED_USING_SCATTER_GATHER
+/**
+ * 分段列表开始发送，每一段按mode计入命令或数据字节
+ */
+static void OLED_Trace_List_Begin(OLED_HandleTypeDef *phandle, const OLED_SegmentTypeDef *psegments, uint16_t count)
+{
+  if (NULL == phandle->ptrace) return;
+  for (uint16_t i = 0; i < count; ++i) OLED_Trace_Bytes(phandle->ptrace, psegments[i].mode, psegments[i].size);
+  OLED_Trace_Begin(phandle->ptrace, OLED_TRACE_LIST_TRANSFER);
+}
+#    define OLED_TRACE_LIST_BEGIN(phandle, psegments, count) OLED_Trace_List_Begin(phandle, psegments, count)
+#  endif
+#else
+#  define OLED_TRACE_BEGIN(phandle, op)
+#  define OLED_TRACE_END(phandle, op, status)
+#  define OLED_TRACE_TRANSFER_BEGIN(phandle, mode, size)
+#  define OLED_TRACE_TRANSFER_END(phandle, mode, status)
+#  define OLED_TRACE_LIST_BEGIN(phandle, psegments, count)
+#endif
+
+/**
+ * 是否使用窗口寻址，控制器支持水平寻址且未定义OLED_USING_PAGE_MODE时使用
+ */
+#ifdef OLED_USING_PAGE_MODE
+#  define OLED_WINDOW_ADDRESS(phandle) 0
+#else
+#  define OLED_WINDOW_ADDRESS(phandle) ((phandle)->pcontroller->horizontal)
+#endif
+
+/**
+ * @brief 一次寻址命令的长度
+ * @note 窗口寻址: 0x21 起始列 结束列 0x22 起始页 结束页
+ * @note 页寻址: 0xb0|页 0x00|列低4位 0x10|列高4位
+ */
+#define OLED_ADDRESS_CMD_LENGTH(phandle) (OLED_WINDOW_ADDRESS(phandle) ? 6 : 3)
+
+#ifdef OLED_USING_HARDWARE_SCROLL
+#  define OLED_GDDRAM_PAGES 8  // 各个控制器的GDDRAM都是64行，只有64行的屏幕才能把GDDRAM当作环形缓冲
+
+/**
+ * 显存页对应的GDDRAM页
+ */
+#  define OLED_RAM_PAGE(phandle, page) (((page) + (phandle)->scroll_page) % (phandle)->pages)
+
+/**
+ * 取出滚动后还没有发送的起始行命令
+ * @param phandle 屏幕实例
+ * @param pcmd 命令输出
+ * @return 命令长度，没有时为0
+ */
+static uint8_t OLED_Take_Start_Line(OLED_HandleTypeDef *phandle, uint8_t *pcmd)
+{
+  if (!phandle->scroll_pending) return 0;
+  phandle->scroll_pending = 0;
+  pcmd[0] = 0x40 | (phandle->scroll_page * 8);
+  return 1;
+}
+#else
+#  define OLED_RAM_PAGE(phandle, page) (page)
+#endif
+
+/**
+ * 窗口寻址时从page开始连续写入不越过GDDRAM最后一页能到达的最后一页
+ * @param phandle 屏幕实例
+ * @param page 起始页
+ * @param page_end 需要写到的页
+ * @return 这一次寻址能写到的最后一页
+ */
+static inline uint8_t OLED_Run_End(const OLED_HandleTypeDef *phandle, uint8_t page, uint8_t page_end)
+{
+#ifdef OLED_USING_HARDWARE_SCROLL
+  uint8_t wrap = phandle->pages - 1 - phandle->scroll_page;  // 写入GDDRAM最后一页的显存页
+  if (page <= wrap && wrap < page_end) return wrap;
+#else
+  UNUSED(phandle);
+  UNUSED(page);
+#endif
+  return page_end;
+}
+
+/**
+ * 生成设置GDDRAM写入位置的命令，列地址加上控制器的列偏移，页号换算为GDDRAM页
+ * @note 窗口寻址模式下同时设置列与页的范围，写满一行后控制器自动换到下一页的起始列，[page_start, page_end]不能跨过GDDRAM最后一页
+ * @note 页寻址模式下只设置起始页和起始列，page_end与x_end不起作用
+ * @note 滚动后还没有发送的起始行命令放在最前面一起发出
+ * @param phandle 屏幕实例
+ * @param pcmd 命令输出，长度至少为OLED_ADDRESS_CMD_MAX_LENGTH
+ * @param x_start 起始列
+ * @param x_end 结束列
+ * @param page_start 起始页
+ * @param page_end 结束页
+ * @return 命令长度
+ */
+static uint8_t OLED_Build_Address(OLED_HandleTypeDef *phandle, uint8_t *pcmd, uint8_t x_start, uint8_t x_end,
+                                  uint8_t page_start, uint8_t page_end)
+{
+  uint8_t offset = phandle->ram_column;
+  uint8_t length = 0;
+#ifdef OLED_USING_HARDWARE_SCROLL
+  length = OLED_Take_Start_Line(phandle, pcmd);
+  pcmd += length;
+#endif
+  page_start = OLED_RAM_PAGE(phandle, page_start);
+  page_end = OLED_RAM_PAGE(phandle, page_end);
+  if (OLED_WINDOW_ADDRESS(phandle)) {
+    pcmd[0] = 0x21;
+    pcmd[1] = x_start + offset;
+    pcmd[2] = x_end + offset;
+    pcmd[3] = 0x22;
+    pcmd[4] = page_start;
+    pcmd[5] = page_end;
+    return length + 6;
+  }
+  uint8_t column = x_start + offset;
+  pcmd[0] = 0xb0 | page_start;
+  pcmd[1] = column & 0x0f;
+  pcmd[2] = 0x10 | (column >> 4);
+  return length + 3;
+}
+
+/**
+ * @brief 寄存器设置的命令字，两字节命令后面跟参数，单字节命令的最低位为参数
+ */
+static const uint8_t s_oled_register_opcode[OLED_REG_COUNT] = {0x81, 0xd9, 0xdb, 0xa4, 0xa6, 0xae};
+
+/**
+ * 取出所有暂存的寄存器设置，按寄存器顺序拼成一条命令，显示开关放在最后
+ * @note 取出即认为屏幕上已经是新值，发送失败时调用OLED_Restore_Registers
+ * @param phandle 屏幕实例
+ * @param pcmd 命令输出，长度至少为OLED_REGISTER_CMD_MAX_LENGTH
+ * @param pmask 输出取出的寄存器
+ * @return 命令长度，没有暂存的设置时为0
+ */
+static uint8_t OLED_Take_Registers(OLED_HandleTypeDef *phandle, uint8_t *pcmd, uint8_t *pmask)
+{
+  uint8_t length = 0;
+  *pmask = phandle->regs_pending;
+  for (uint8_t reg = 0; reg < OLED_REG_COUNT; ++reg) {
+    if (!(*pmask >> reg & 1U)) continue;
+    uint8_t value = phandle->regs_staged[reg];
+    if (reg < OLED_REG_ENTIRE_ON) {
+      pcmd[length++] = s_oled_register_opcode[reg];
+      pcmd[length++] = value;
+    } else {
+      pcmd[length++] = s_oled_register_opcode[reg] | value;
+    }
+    phandle->regs[reg] = value;
+  }
+  phandle->regs_known |= *pmask;
+  phandle->regs_pending = 0;
+  return length;
+}
+
+/**
+ * 取出的寄存器设置没有发送成功，屏幕上的值变为未知，重新暂存等待下一次发送
+ * @param phandle 屏幕实例
+ * @param mask OLED_Take_Registers取出的寄存器
+ */
+static inline void OLED_Restore_Registers(OLED_HandleTypeDef *phandle, uint8_t mask)
+{
+  phandle->regs_known &= ~mask;
+  phandle->regs_pending |= mask;
+}
+
+#ifdef OLED_USING_PARTIAL_REFRESH
+/**
+ * @brief 一段区间的固定开销: 一次寻址命令加上命令、数据两次传输的开销
+ * @brief 两段区间间隔小于这个值时合并发送更省
+ */
+#  define OLED_SPAN_OVERHEAD(phandle) (OLED_ADDRESS_CMD_LENGTH(phandle) + 2 * OLED_TRANSFER_OVERHEAD)
+
+/**
+ * 标记某一页中的一个点需要刷新
+ * @param phandle 屏幕实例
+ * @param page 页号
+ * @param x 列号
+ */
+static inline void OLED_Mark_Dirty_Point(OLED_HandleTypeDef *phandle, uint8_t page, uint8_t x)
+{
+  if (x < phandle->dirty_start[page]) phandle->dirty_start[page] = x;
+  if (x > phandle->dirty_end[page]) phandle->dirty_end[page] = x;
+}
+#  define OLED_MARK_DIRTY_POINT(phandle, page, x) OLED_Mark_Dirty_Point(phandle, page, x)
+#else
+#  define OLED_MARK_DIRTY_POINT(phandle, page, x)
+#endif
+
+/**
+ * @brief 段/COM扫描方向，初始化表以0xa1/0xc8为正常方向，180度时两个方向都反过来，由控制器完成旋转
+ */
+#if OLED_ROTATION == 180
+#  define OLED_SEGMENT_REMAP 0xa0
+#  define OLED_COM_SCAN 0xc0
+#else
+#  define OLED_SEGMENT_REMAP 0xa1
+#  define OLED_COM_SCAN 0xc8
+#endif
+
+/**
+ * OLED初始化函数
  * @return OLED Status
  */
-OLED_StatusTypeDef OLED_WriteCmd(uint8_t *pcmd, uint16_t total);
+OLED_StatusTypeDef OLEDH_Init(OLED_HandleTypeDef *phandle)
+{
+  if (NULL == phandle->ptransport || 0 == phandle->width || 0 == phandle->height) return OLED_ERROR;
+#ifndef OLED_USING_STRIP_RENDER
+  if (NULL == phandle->pbuffer) return OLED_ERROR;  // 只分条渲染时可以没有显存
+#endif
+  if (NULL == phandle->pcontroller) phandle->pcontroller = &OLED_DEFAULT_CONTROLLER;
+  const OLED_ControllerTypeDef *pcontroller = phandle->pcontroller;
+  uint8_t offset = pcontroller->column_offset + phandle->column_offset;
+  if (phandle->width + offset > pcontroller->ram_width) return OLED_ERROR;
+#if OLED_ROTATION == 180
+  // 段重映射反过来之后屏幕第0列接在GDDRAM的另一端，偏移从另一端数起
+  phandle->ram_column = pcontroller->ram_width - phandle->width - offset;
+#else
+  phandle->ram_column = offset;
+#endif
+  phandle->pages = (phandle->height + 7) / 8;
+  if (phandle->pages > OLED_MAX_PAGE_SIZE) return OLED_ERROR;
+#ifdef OLED_USING_HARDWARE_SCROLL
+  phandle->scroll_page = 0;  // 初始化命令把起始行设为0
+  phandle->scroll_pending = 0;
+#endif
+#ifdef OLED_USING_DMA_TRANSMIT
+  phandle->refresh_state = OLED_REFRESH_IDLE;
+  phandle->pnext = NULL;
+#endif
+#ifdef OLED_USING_PARTIAL_REFRESH
+  phandle->job.regs_length = 0;
+  phandle->job.regs_mask = 0;
+#endif
+  phandle->regs_known = 0;
+  phandle->regs_pending = 0;
+  OLEDH_MARK_ALL_DIRTY(phandle);
+  OLED_StatusTypeDef status = OLEDH_WriteCmd(phandle, pcontroller->pinit, pcontroller->init_length);
+  if (OLED_OK != status) return status;
+  uint8_t geometry[] = {
+      0xa8, phandle->height < 16 ? 15 : phandle->height - 1,  // 多路复用比，控制器最少16路
+      0xda, phandle->com_pins ? phandle->com_pins : OLED_DEFAULT_COM_PINS(phandle->width, phandle->height),
+      OLED_SEGMENT_REMAP,
+      OLED_COM_SCAN,
+      // 支持水平寻址的芯片默认使用水平寻址，定义OLED_USING_PAGE_MODE时改为页寻址
+      0x20, OLED_WINDOW_ADDRESS(phandle) ? 0x00 : 0x02,
+  };
+  // 只能页寻址的芯片不发送0x20
+  status = OLEDH_WriteCmd(phandle, geometry, CALC_NUM_LENGTH(geometry) - (pcontroller->horizontal ? 0 : 2));
+  if (OLED_OK != status) return status;
+  status = OLEDH_ON(phandle);
+  if (OLED_OK != status) return status;
+  // 初始化表都以0xa4、0xa6开始，其余寄存器的值随芯片不同，第一次设置时总是发送
+  phandle->regs[OLED_REG_ENTIRE_ON] = 0;
+  phandle->regs[OLED_REG_INVERT] = 0;
+  phandle->regs_known |= 1U << OLED_REG_ENTIRE_ON | 1U << OLED_REG_INVERT;
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLED_Init(void) { return OLEDH_Init(&g_oled_handle); }
 
 /**
- * @breif 定义两个数组
- * @parm g_oled_buffer作为图形缓存
- * @parm g_command_buffer作为命令缓存
+ * 发送一段显示数据，超过控制器的max_transfer时分多次发送
+ * @param phandle 屏幕实例
+ * @param pdata 数据指针
+ * @param size 数据长度
+ * @return OLED Status
  */
-uint8_t g_oled_buffer[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
-uint8_t g_command_buffer[OLED_COMMAND_BUFFER_LENGTH];
+static OLED_StatusTypeDef OLED_Send_Data(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint16_t size)
+{
+  uint16_t limit = phandle->pcontroller->max_transfer;
+  OLED_StatusTypeDef status = OLED_OK;
+  while (OLED_OK == status && size > 0) {
+    uint16_t chunk = 0 != limit && size > limit ? limit : size;
+    OLED_TRACE_TRANSFER_BEGIN(phandle, 1, chunk);
+    OLED_TRANSPORT_BEFORE(phandle, 1);
+    status = phandle->ptransport->transmit(phandle, pdata, chunk, 1);
+    OLED_TRANSPORT_AFTER(phandle, 1);
+    OLED_TRACE_TRANSFER_END(phandle, 1, status);
+    pdata += chunk;
+    size -= chunk;
+  }
+  return status;
+}
+
+OLED_StatusTypeDef OLEDH_Set_Window(OLED_HandleTypeDef *phandle, uint8_t x_start, uint8_t x_end, uint8_t page_start,
+                                    uint8_t page_end)
+{
+  uint8_t cmd[OLED_REGISTER_CMD_MAX_LENGTH + OLED_ADDRESS_CMD_MAX_LENGTH];
+  uint8_t mask;
+  if (x_start > x_end || x_end >= phandle->width || page_start > page_end || page_end >= phandle->pages)
+    return OLED_OUT_RANGE;
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;  // 总线正在发送异步刷新
+#endif
+  uint8_t length = OLED_Take_Registers(phandle, cmd, &mask);
+  length += OLED_Build_Address(phandle, cmd + length, x_start, x_end, page_start, page_end);
+  OLED_StatusTypeDef status = OLEDH_WriteCmd(phandle, cmd, length);
+  if (OLED_OK != status) OLED_Restore_Registers(phandle, mask);
+  return status;
+}
+
+OLED_StatusTypeDef OLEDH_Write_Data(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint16_t size)
+{
 #ifdef OLED_USING_DMA_TRANSMIT
-uint8_t g_call_refresh_count = 0;
-uint8_t gb_call_refresh = 0;
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;  // 总线正在发送异步刷新
 #endif
+  return OLED_Send_Data(phandle, pdata, size);
+}
+
+OLED_StatusTypeDef OLED_Set_Window(uint8_t x_start, uint8_t x_end, uint8_t page_start, uint8_t page_end)
+{
+  return OLEDH_Set_Window(&g_oled_handle, x_start, x_end, page_start, page_end);
+}
+
+OLED_StatusTypeDef OLED_Write_Data(uint8_t *pdata, uint16_t size)
+{
+  return OLEDH_Write_Data(&g_oled_handle, pdata, size);
+}
+
+#ifndef OLED_USING_PARTIAL_REFRESH
 
 /**
- * OLED初始化函数
+ * 把按页存储的数据以整行宽度写到[page_start, page_end]页
+ * @note 窗口寻址时设置窗口后一次发完(滚动后GDDRAM回绕处分两次)，页寻址时逐页寻址发送
+ * @param phandle 屏幕实例
+ * @param pdata 数据来源，第一个字节对应page_start页的第0列
+ * @param page_start 起始页
+ * @param page_end 结束页
+ * @return OLED Status
+ */
+static OLED_StatusTypeDef OLED_Send_Pages(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint8_t page_start,
+                                          uint8_t page_end)
+{
+  uint8_t cmd[OLED_REGISTER_CMD_MAX_LENGTH + OLED_ADDRESS_CMD_MAX_LENGTH];
+  uint8_t length, last, mask;
+  OLED_StatusTypeDef status = OLED_OK;
+  OLED_TRACE_BEGIN(phandle, OLED_TRACE_REFRESH);
+  length = OLED_Take_Registers(phandle, cmd, &mask);  // 暂存的设置随第一条寻址命令发出
+  for (uint8_t page = page_start; OLED_OK == status && page <= page_end; page = last + 1) {
+    last = OLED_WINDOW_ADDRESS(phandle) ? OLED_Run_End(phandle, page, page_end) : page;
+    length += OLED_Build_Address(phandle, cmd + length, 0, phandle->width - 1, page, last);
+    status = OLEDH_WriteCmd(phandle, cmd, length);
+    if (OLED_OK != status && page_start == page) OLED_Restore_Registers(phandle, mask);
+    if (OLED_OK == status)
+      status = OLED_Send_Data(phandle, pdata + (page - page_start) * phandle->width,
+                              phandle->width * (last - page + 1));
+    length = 0;
+  }
+  OLED_TRACE_END(phandle, OLED_TRACE_REFRESH, status);
+  return status;
+}
+
+/**
+ * 将显存里面的内容更新到屏幕中
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLEDH_Refresh_GSRAM(OLED_HandleTypeDef *phandle)
+{
+#ifdef OLED_USING_HARDWARE_SCROLL
+  phandle->scroll_pending = 1;  // 屏幕内容整屏重写，顺带保证起始行与显存一致
+#endif
+  return OLED_Send_Pages(phandle, phandle->pbuffer, 0, phandle->pages - 1);
+}
+#else
+
+/**
+ * 估算刷新一个矩形区域需要占用的总线字节数
+ * @param phandle 屏幕实例
+ * @param pwin 区域
+ * @return 总线字节数
+ */
+static uint32_t OLED_Window_Cost(const OLED_HandleTypeDef *phandle, const OLED_WindowTypeDef *pwin)
+{
+  uint32_t width = pwin->x_end - pwin->x_start + 1;
+  uint32_t pages = pwin->page_end - pwin->page_start + 1;
+  if (OLED_WINDOW_ADDRESS(phandle)) {
+    uint32_t cost = OLED_ADDRESS_CMD_LENGTH(phandle) + OLED_TRANSFER_OVERHEAD;
+    if (phandle->width == width) return cost + OLED_TRANSFER_OVERHEAD + width * pages;
+    return cost + pages * (OLED_TRANSFER_OVERHEAD + width);
+  }
+  return pages * (OLED_SPAN_OVERHEAD(phandle) + width);
+}
+
+/**
+ * 清除所有脏区标记
+ * @param phandle 屏幕实例
+ */
+static void OLED_Clear_Dirty(OLED_HandleTypeDef *phandle)
+{
+  memset(phandle->dirty_start, 0xff, sizeof(phandle->dirty_start));
+  memset(phandle->dirty_end, 0x00, sizeof(phandle->dirty_end));
+  phandle->refresh_all = 0;
+}
+
+void OLEDH_Mark_Dirty(OLED_HandleTypeDef *phandle, uint8_t x_start, uint8_t x_end, uint8_t page_start,
+                      uint8_t page_end)
+{
+  if (x_end >= phandle->width) x_end = phandle->width - 1;
+  if (page_end >= phandle->pages) page_end = phandle->pages - 1;
+  for (uint8_t page = page_start; page <= page_end; ++page) {
+    if (x_start < phandle->dirty_start[page]) phandle->dirty_start[page] = x_start;
+    if (x_end > phandle->dirty_end[page]) phandle->dirty_end[page] = x_end;
+  }
+}
+
+void OLEDH_Mark_All_Dirty(OLED_HandleTypeDef *phandle) { phandle->refresh_all = 1; }
+
+void OLED_Mark_Dirty(uint8_t x_start, uint8_t x_end, uint8_t page_start, uint8_t page_end)
+{
+  OLEDH_Mark_Dirty(&g_oled_handle, x_start, x_end, page_start, page_end);
+}
+
+void OLED_Mark_All_Dirty(void) { OLEDH_Mark_All_Dirty(&g_oled_handle); }
+
+#  ifndef OLED_USING_SHADOW_REFRESH
+/**
+ * 收集各页的脏区
+ * @param phandle 屏幕实例
+ * @param pwindows 输出的区域列表，长度至少为页数
+ * @return 区域个数
+ */
+static uint8_t OLED_Collect_Dirty(const OLED_HandleTypeDef *phandle, OLED_WindowTypeDef *pwindows)
+{
+  uint8_t count = 0;
+  for (uint8_t page = 0; page < phandle->pages; ++page) {
+    if (phandle->dirty_start[page] > phandle->dirty_end[page]) continue;
+    pwindows[count++] = (OLED_WindowTypeDef){phandle->dirty_start[page], phandle->dirty_end[page], page, page};
+  }
+  return count;
+}
+#  else
+/**
+ * 逐字比较显存与影子帧，找出所有不同的连续区间
+ * @note 两段区间之间相同的字节数小于一次重新寻址的开销时合并为一段
+ * @param phandle 屏幕实例
+ * @param pwindows 输出的区域列表，长度为OLED_REFRESH_MAX_SPANS
+ * @return 区域个数，超出列表长度时返回OLED_REFRESH_MAX_SPANS + 1
+ */
+static uint8_t OLED_Collect_Diff(const OLED_HandleTypeDef *phandle, OLED_WindowTypeDef *pwindows)
+{
+  uint8_t count = 0;
+  const uint16_t width = phandle->width;
+  const uint8_t overhead = OLED_SPAN_OVERHEAD(phandle);
+  for (uint8_t page = 0; page < phandle->pages; ++page) {
+    const uint8_t *pcur = phandle->pbuffer + page * width;
+    const uint8_t *pold = phandle->pshadow + page * width;
+    int16_t run_start = -1, run_end = -1;
+    for (uint16_t x = 0; x < width; x += sizeof(OLED_DiffWordTypeDef)) {
+      if (x + sizeof(OLED_DiffWordTypeDef) <= width) {
+        OLED_DiffWordTypeDef cur, old;
+        memcpy(&cur, pcur + x, sizeof(cur));
+        memcpy(&old, pold + x, sizeof(old));
+        if (cur == old) continue;
+      }
+      for (uint16_t i = x; i < x + sizeof(OLED_DiffWordTypeDef) && i < width; ++i) {
+        if (pcur[i] == pold[i]) continue;
+        if (run_start >= 0 && i - run_end - 1 >= overhead) {
+          if (count >= OLED_REFRESH_MAX_SPANS) return OLED_REFRESH_MAX_SPANS + 1;
+          pwindows[count++] = (OLED_WindowTypeDef){run_start, run_end, page, page};
+          run_start = -1;
+        }
+        if (run_start < 0) run_start = i;
+        run_end = i;
+      }
+    }
+    if (run_start < 0) continue;
+    if (count >= OLED_REFRESH_MAX_SPANS) return OLED_REFRESH_MAX_SPANS + 1;
+    pwindows[count++] = (OLED_WindowTypeDef){run_start, run_end, page, page};
+  }
+  return count;
+}
+#  endif
+
+/**
+ * 根据收集到的区域决定发送方式
+ * @note 在逐段发送、发送外接矩形(仅窗口寻址)、整屏发送三种方式中选择总线字节数最少的
+ * @param phandle 屏幕实例，job.windows中为收集到的区域
+ * @param count 区域个数，大于OLED_REFRESH_MAX_SPANS时直接整屏发送
+ */
+static void OLED_Job_Plan(OLED_HandleTypeDef *phandle, uint8_t count)
+{
+  OLED_RefreshJobTypeDef *pjob = &phandle->job;
+  OLED_WindowTypeDef *pwindows = pjob->windows;
+  const OLED_WindowTypeDef full = {0, phandle->width - 1, 0, phandle->pages - 1};
+  pjob->count = 1;
+  if (count > OLED_REFRESH_MAX_SPANS) {
+    pwindows[0] = full;
+    return;
+  }
+
+  OLED_WindowTypeDef box = {0xff, 0, 0xff, 0};
+  uint32_t span_cost = 0;
+  for (uint8_t i = 0; i < count; ++i) {
+    span_cost += OLED_Window_Cost(phandle, &pwindows[i]);
+    if (pwindows[i].x_start < box.x_start) box.x_start = pwindows[i].x_start;
+    if (pwindows[i].x_end > box.x_end) box.x_end = pwindows[i].x_end;
+    if (pwindows[i].page_start < box.page_start) box.page_start = pwindows[i].page_start;
+    if (pwindows[i].page_end > box.page_end) box.page_end = pwindows[i].page_end;
+  }
+  uint32_t full_cost = OLED_Window_Cost(phandle, &full);
+  // 页寻址下外接矩形不会比逐段发送更省
+  uint32_t box_cost = OLED_WINDOW_ADDRESS(phandle) ? OLED_Window_Cost(phandle, &box) : span_cost;
+  if (full_cost <= span_cost && full_cost <= box_cost)
+    pwindows[0] = full;
+  else if (box_cost < span_cost)
+    pwindows[0] = box;
+  else
+    pjob->count = count;
+}
+
+/**
+ * 从job.windows中的第一个区域开始执行任务，取出暂存的寄存器设置放在第一条寻址命令前面
+ * @param phandle 屏幕实例
+ * @param pframe 发送的数据来源
+ * @param frame_page pframe第一行所在的页
+ */
+static void OLED_Job_Start(OLED_HandleTypeDef *phandle, uint8_t *pframe, uint8_t frame_page)
+{
+  OLED_RefreshJobTypeDef *pjob = &phandle->job;
+  pjob->regs_length = OLED_Take_Registers(phandle, pjob->regs_cmd, &pjob->regs_mask);
+  pjob->pframe = pframe;
+  pjob->frame_page = frame_page;
+  pjob->index = 0;
+  pjob->page = pjob->windows[0].page_start;
+  pjob->phase = 0;
+  pjob->offset = 0;
+}
+
+/**
+ * 生成把一段按页存储的数据整行写到[page_start, page_end]页的任务
+ * @param phandle 屏幕实例
+ * @param pdata 数据来源，第一个字节对应page_start页的第0列
+ * @param page_start 起始页
+ * @param page_end 结束页
+ */
+static void OLED_Job_Pages(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint8_t page_start, uint8_t page_end)
+{
+  OLED_RefreshJobTypeDef *pjob = &phandle->job;
+  OLED_Restore_Registers(phandle, pjob->regs_mask);  // 上一次任务出错时没有清零，重新发送
+  pjob->windows[0] = (OLED_WindowTypeDef){0, phandle->width - 1, page_start, page_end};
+  pjob->count = 1;
+  OLED_Job_Start(phandle, pdata, page_start);
+}
+
+/**
+ * 收集改动区域并生成刷新任务，随后清除脏区标记
+ * @note pframe不是显存时会先把要发送的区域拷贝过去，发送期间可以继续修改显存
+ * @param phandle 屏幕实例
+ * @param pframe 发送的数据来源
+ * @return 没有需要发送的内容时返回0
+ */
+static uint8_t OLED_Job_Prepare(OLED_HandleTypeDef *phandle, uint8_t *pframe)
+{
+  OLED_RefreshJobTypeDef *pjob = &phandle->job;
+  uint8_t count = OLED_REFRESH_MAX_SPANS + 1;
+#  ifdef OLED_USING_SHADOW_REFRESH
+  if (!phandle->refresh_all) count = OLED_Collect_Diff(phandle, pjob->windows);
+#  else
+  if (!phandle->refresh_all) count = OLED_Collect_Dirty(phandle, pjob->windows);
+#  endif
+  OLED_Restore_Registers(phandle, pjob->regs_mask);  // 上一次任务出错时没有清零，重新发送
+  uint8_t commands = 0 != phandle->regs_pending;
+#  ifdef OLED_USING_HARDWARE_SCROLL
+  if (phandle->refresh_all) phandle->scroll_pending = 1;  // 整屏重写时顺带保证起始行与显存一致
+  commands |= phandle->scroll_pending;
+#  endif
+  if (0 == count && commands) {
+    pjob->windows[0] = (OLED_WindowTypeDef){0, 0, 0, 0};  // 没有改动时发送一个字节带上等待发送的命令
+    count = 1;
+  }
+  if (0 == count) return 0;
+  OLED_Job_Plan(phandle, count);
+
+  if (pframe != phandle->pbuffer) {
+    for (uint8_t i = 0; i < pjob->count; ++i) {
+      const OLED_WindowTypeDef *pwin = &pjob->windows[i];
+      for (uint8_t page = pwin->page_start; page <= pwin->page_end; ++page) {
+        uint16_t offset = page * phandle->width + pwin->x_start;
+        memcpy(pframe + offset, phandle->pbuffer + offset, pwin->x_end - pwin->x_start + 1);
+      }
+    }
+  }
+  OLED_Job_Start(phandle, pframe, 0);
+  OLED_Clear_Dirty(phandle);
+  return 1;
+}
+
+/**
+ * 取出刷新任务的下一步
+ * @note 窗口寻址每个区域只寻址一次(滚动后跨过GDDRAM回绕处时两次)，整行宽度时所有页的数据一次发完；页寻址每一页都要重新寻址
+ * @note 一段数据超过控制器的max_transfer时分多步发出
+ * @param phandle 屏幕实例
+ * @param pcmd 这一步是寻址命令时命令存放的位置，长度为OLED_ADDRESS_CMD_MAX_LENGTH
+ * @param pmode 输出传输模式:0->命令;1->数据
+ * @param ppdata 输出数据指针
+ * @param psize 输出数据长度
+ * @return 任务已经完成时返回0
+ */
+static uint8_t OLED_Job_Next(OLED_HandleTypeDef *phandle, uint8_t *pcmd, uint8_t *pmode, uint8_t **ppdata,
+                             uint16_t *psize)
+{
+  OLED_RefreshJobTypeDef *pjob = &phandle->job;
+  if (pjob->index >= pjob->count) return 0;
+  const OLED_WindowTypeDef *pwin = &pjob->windows[pjob->index];
+  uint8_t window = OLED_WINDOW_ADDRESS(phandle);
+  uint8_t last = window ? OLED_Run_End(phandle, pjob->page, pwin->page_end) : pjob->page;
+  if (0 == pjob->phase) {
+    uint8_t length = pjob->regs_length;
+    if (0 != length) pcmd = pjob->regs_cmd;  // 第一条寻址命令接在暂存的寄存器设置后面
+    *psize = length + OLED_Build_Address(phandle, pcmd + length, pwin->x_start, pwin->x_end, pjob->page, last);
+    pjob->regs_length = 0;
+    pjob->phase = 1;
+    *pmode = 0;
+    *ppdata = pcmd;
+    return 1;
+  }
+
+  uint16_t width = pwin->x_end - pwin->x_start + 1;
+  uint16_t size = width;
+  if (window && phandle->width == width) size = width * (last - pjob->page + 1);
+  uint16_t limit = phandle->pcontroller->max_transfer;
+  *pmode = 1;
+  *ppdata = pjob->pframe + (pjob->page - pjob->frame_page) * phandle->width + pwin->x_start + pjob->offset;
+  if (0 != limit && size - pjob->offset > limit) {
+    *psize = limit;
+    pjob->offset += limit;
+    return 1;
+  }
+  *psize = size - pjob->offset;
+  pjob->offset = 0;
+  if (window && phandle->width == width) pjob->page = last;
+  if (pjob->page == last) pjob->phase = 0;  // 页寻址每页、窗口寻址写到窗口末尾或GDDRAM回绕处时重新寻址
+  if (pjob->page++ >= pwin->page_end) {
+    pjob->phase = 0;
+    if (++pjob->index < pjob->count) pjob->page = pjob->windows[pjob->index].page_start;
+  }
+  return 1;
+}
+
+#  ifdef OLED_USING_SCATTER_GATHER
+/**
+ * 把刷新任务接下来的若干步收集成一个分段列表，显示数据直接引用发送缓存
+ * @param phandle 屏幕实例
+ * @return 段数，任务已经完成时返回0
+ */
+static uint16_t OLED_Job_Collect(OLED_HandleTypeDef *phandle)
+{
+  OLED_RefreshJobTypeDef *pjob = &phandle->job;
+  uint16_t count = 0;
+  uint8_t cmds = 0, *pdata;
+  while (count < OLED_SEGMENT_LIST_LENGTH) {
+    OLED_SegmentTypeDef *psegment = &pjob->segments[count];
+    if (!OLED_Job_Next(phandle, pjob->cmds[cmds], &psegment->mode, &pdata, &psegment->size)) break;
+    psegment->pdata = pdata;
+    if (0 == psegment->mode) cmds++;
+    count++;
+  }
+  return count;
+}
+#  endif
+
+/**
+ * 阻塞地执行完一个刷新任务
+ * @note 每一段传输前后调用传输函数表中的钩子函数，以便SPI切换DC引脚
+ * @note 传输函数表提供transmit_list时按分段列表提交，每个列表只调用一次传输函数
+ * @param phandle 屏幕实例
  * @return OLED Status
  */
-OLED_StatusTypeDef OLED_Init(void)
+static OLED_StatusTypeDef OLED_Job_Run(OLED_HandleTypeDef *phandle)
 {
-  return OLED_WriteCmd((uint8_t *)__oled_init_param, CALC_NUM_LENGTH(__oled_init_param));
+  OLED_StatusTypeDef status = OLED_OK;
+  uint8_t mode, *pdata;
+  uint16_t size;
+#  ifdef OLED_USING_SCATTER_GATHER
+  if (NULL != phandle->ptransport->transmit_list) {
+    uint16_t count;
+    while (OLED_OK == status && 0 != (count = OLED_Job_Collect(phandle))) {
+      OLED_TRACE_LIST_BEGIN(phandle, phandle->job.segments, count);
+      status = phandle->ptransport->transmit_list(phandle, phandle->job.segments, count);
+      OLED_TRACE_END(phandle, OLED_TRACE_LIST_TRANSFER, status);
+    }
+    return status;
+  }
+#  endif
+  while (OLED_OK == status && OLED_Job_Next(phandle, phandle->job.cmd, &mode, &pdata, &size)) {
+    OLED_TRACE_TRANSFER_BEGIN(phandle, mode, size);
+    OLED_TRANSPORT_BEFORE(phandle, mode);
+    status = phandle->ptransport->transmit(phandle, pdata, size, mode);
+    OLED_TRANSPORT_AFTER(phandle, mode);
+    OLED_TRACE_TRANSFER_END(phandle, mode, status);
+  }
+  return status;
 }
 
 /**
- * 将g_oled_buffer里面的内容更新到屏幕中
+ * 只把显存中改动过的区域更新到屏幕中
+ * @note 定义OLED_USING_SHADOW_REFRESH时与上一次发送的帧逐字比较得到改动区域，否则使用绘图函数记录的脏区
  * @return OLED Status
  */
-OLED_StatusTypeDef OLED_Refresh_GSRAM()
+OLED_StatusTypeDef OLEDH_Refresh_GSRAM(OLED_HandleTypeDef *phandle)
 {
-  OLED_Refresh_GSRAM_CallBefore();
-  OLED_StatusTypeDef status;
-  status = OLED_Transmit(OLED_PHY_ADDRESS, 0x40, (uint8_t *)g_oled_buffer, OLED_PIX_WIDTH * OLED_PAGE_SIZE, 1);
-  OLED_Refresh_GSRAM_CallAfter();
+#  ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;
+#  endif
+  OLED_StatusTypeDef status = OLED_OK;
+  OLED_TRACE_BEGIN(phandle, OLED_TRACE_REFRESH);
+#  ifdef OLED_USING_SHADOW_REFRESH
+  if (OLED_Job_Prepare(phandle, phandle->pshadow)) status = OLED_Job_Run(phandle);
+#  else
+  if (OLED_Job_Prepare(phandle, phandle->pbuffer)) status = OLED_Job_Run(phandle);
+#  endif
+  if (OLED_OK != status)
+    phandle->refresh_all = 1;  // 屏幕内容已经未知，下次整屏发送
+  else
+    phandle->job.regs_mask = 0;  // 带上的寄存器设置已经发出
+  OLED_TRACE_END(phandle, OLED_TRACE_REFRESH, status);
+  return status;
+}
+
+#  ifdef OLED_USING_DMA_TRANSMIT
+#    define OLED_ASYNC_MODE_LIST 0x02U  // 正在发送的是一个分段列表，完成后不调用after钩子
+
+#    ifdef OLED_USING_TRACE
+/**
+ * 异步发出的一次传输结束
+ */
+static inline void OLED_Trace_Async_End(OLED_HandleTypeDef *phandle, OLED_StatusTypeDef status)
+{
+  if (NULL == phandle->ptrace) return;
+  OLED_TraceOpTypeDef op = OLED_TRACE_TRANSFER_OP(phandle->async_mode);
+  if (OLED_ASYNC_MODE_LIST == phandle->async_mode) op = OLED_TRACE_LIST_TRANSFER;
+  OLED_Trace_End(phandle->ptrace, op, OLED_OK != status);
+}
+#      define OLED_TRACE_ASYNC_END(phandle, status) OLED_Trace_Async_End(phandle, status)
+#    else
+#      define OLED_TRACE_ASYNC_END(phandle, status)
+#    endif
+
+/**
+ * 发出刷新任务的下一次传输，提供transmit_list时一次发出一个分段列表
+ * @param phandle 屏幕实例
+ * @param pstatus 输出传输函数的返回值
+ * @return 任务已经完成时返回0
+ */
+static uint8_t OLED_Async_Transmit(OLED_HandleTypeDef *phandle, OLED_StatusTypeDef *pstatus)
+{
+  uint8_t *pdata;
+  uint16_t size;
+#    ifdef OLED_USING_SCATTER_GATHER
+  if (NULL != phandle->ptransport->transmit_list) {
+    uint16_t count = OLED_Job_Collect(phandle);
+    if (0 == count) return 0;
+    phandle->async_mode = OLED_ASYNC_MODE_LIST;
+    OLED_TRACE_LIST_BEGIN(phandle, phandle->job.segments, count);
+    *pstatus = phandle->ptransport->transmit_list(phandle, phandle->job.segments, count);
+    return 1;
+  }
+#    endif
+  if (!OLED_Job_Next(phandle, phandle->job.cmd, &phandle->async_mode, &pdata, &size)) return 0;
+  OLED_TRACE_TRANSFER_BEGIN(phandle, phandle->async_mode, size);
+  OLED_TRANSPORT_BEFORE(phandle, phandle->async_mode);
+  *pstatus = phandle->ptransport->transmit(phandle, pdata, size, phandle->async_mode);
+  return 1;
+}
+
+/**
+ * 发出异步刷新任务的下一步，任务完成时回到空闲状态
+ * @note 一块屏幕结束(完成或出错)后接着发送同一总线上排在它后面的屏幕
+ * @param phandle 屏幕实例
+ */
+static void OLED_Async_Step(OLED_HandleTypeDef *phandle)
+{
+  while (NULL != phandle) {
+    OLED_StatusTypeDef status;
+    if (OLED_Async_Transmit(phandle, &status)) {
+      if (OLED_OK == status) return;
+      OLED_TRACE_ASYNC_END(phandle, status);  // 传输没能发起
+      phandle->refresh_all = 1;
+      phandle->refresh_state = OLED_REFRESH_ERROR;
+      OLED_TRACE_END(phandle, OLED_TRACE_REFRESH_ASYNC, status);
+    } else {
+      phandle->job.regs_mask = 0;
+      phandle->refresh_state = OLED_REFRESH_IDLE;
+      OLED_TRACE_END(phandle, OLED_TRACE_REFRESH_ASYNC, OLED_OK);
+      if (NULL != phandle->ptransport->complete) phandle->ptransport->complete(phandle);
+    }
+    OLED_HandleTypeDef *pnext = phandle->pnext;
+    phandle->pnext = NULL;
+    phandle = pnext;
+  }
+}
+
+/**
+ * 生成异步刷新任务，把改动区域拷贝到发送缓存
+ * @param phandle 屏幕实例
+ * @return 没有需要发送的内容时返回0
+ */
+static uint8_t OLED_Async_Prepare(OLED_HandleTypeDef *phandle)
+{
+  OLED_TRACE_BEGIN(phandle, OLED_TRACE_REFRESH_ASYNC);  // 没有需要发送的内容时不会结束，也就不计入统计
+#    ifdef OLED_USING_SHADOW_REFRESH
+  uint8_t pending = OLED_Job_Prepare(phandle, phandle->pshadow);
+#    else
+  uint8_t pending = OLED_Job_Prepare(phandle, phandle->ptx);
+#    endif
+  phandle->pnext = NULL;
+  phandle->refresh_state = pending ? OLED_REFRESH_BUSY : OLED_REFRESH_IDLE;
+  return pending;
+}
+
+OLED_StatusTypeDef OLEDH_Refresh_Async(OLED_HandleTypeDef *phandle)
+{
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;
+  if (!OLED_Async_Prepare(phandle)) return OLED_OK;
+  OLED_Async_Step(phandle);
+  return OLED_REFRESH_ERROR == phandle->refresh_state ? OLED_ERROR : OLED_OK;
+}
+
+void OLEDH_Transmit_Done(OLED_HandleTypeDef *phandle, OLED_StatusTypeDef status)
+{
+  if (OLED_REFRESH_BUSY != phandle->refresh_state) return;
+  if (OLED_ASYNC_MODE_LIST != phandle->async_mode) OLED_TRANSPORT_AFTER(phandle, phandle->async_mode);
+  OLED_TRACE_ASYNC_END(phandle, status);
+  if (OLED_OK != status) {
+    OLED_HandleTypeDef *pnext = phandle->pnext;
+    phandle->pnext = NULL;
+    phandle->refresh_all = 1;
+    phandle->refresh_state = OLED_REFRESH_ERROR;
+    OLED_TRACE_END(phandle, OLED_TRACE_REFRESH_ASYNC, status);
+    OLED_Async_Step(pnext);
+    return;
+  }
+  OLED_Async_Step(phandle);
+}
+
+OLED_RefreshStateTypeDef OLEDH_Get_Refresh_State(OLED_HandleTypeDef *phandle) { return phandle->refresh_state; }
+
+OLED_StatusTypeDef OLEDH_Wait_Refresh(OLED_HandleTypeDef *phandle)
+{
+  while (OLED_REFRESH_BUSY == phandle->refresh_state) OLED_Wait_Refresh_Idle();
+  return OLED_REFRESH_ERROR == phandle->refresh_state ? OLED_ERROR : OLED_OK;
+}
+
+OLED_StatusTypeDef OLED_Refresh_Async(void) { return OLEDH_Refresh_Async(&g_oled_handle); }
+
+void OLED_Transmit_Done(OLED_StatusTypeDef status) { OLEDH_Transmit_Done(&g_oled_handle, status); }
+
+OLED_RefreshStateTypeDef OLED_Get_Refresh_State(void) { return OLEDH_Get_Refresh_State(&g_oled_handle); }
+
+OLED_StatusTypeDef OLED_Wait_Refresh(void) { return OLEDH_Wait_Refresh(&g_oled_handle); }
+#  endif
+#endif
+
+OLED_StatusTypeDef OLED_Refresh_GSRAM() { return OLEDH_Refresh_GSRAM(&g_oled_handle); }
+
+OLED_StatusTypeDef OLEDH_Write_Pages(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint8_t page_start,
+                                     uint8_t page_end)
+{
+  if (page_start > page_end || page_end >= phandle->pages) return OLED_OUT_RANGE;
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;
+#endif
+  OLEDH_MARK_ALL_DIRTY(phandle);  // 屏幕上的这几页不再来自显存，与影子帧也对不上
+#ifndef OLED_USING_PARTIAL_REFRESH
+  return OLED_Send_Pages(phandle, pdata, page_start, page_end);
+#elif defined(OLED_USING_DMA_TRANSMIT)
+  OLED_TRACE_BEGIN(phandle, OLED_TRACE_REFRESH_ASYNC);
+  OLED_Job_Pages(phandle, pdata, page_start, page_end);
+  phandle->pnext = NULL;
+  phandle->refresh_state = OLED_REFRESH_BUSY;
+  OLED_Async_Step(phandle);
+  return OLED_REFRESH_ERROR == phandle->refresh_state ? OLED_ERROR : OLED_OK;
+#else
+  OLED_TRACE_BEGIN(phandle, OLED_TRACE_REFRESH);
+  OLED_Job_Pages(phandle, pdata, page_start, page_end);
+  OLED_StatusTypeDef status = OLED_Job_Run(phandle);
+  if (OLED_OK == status) phandle->job.regs_mask = 0;
+  OLED_TRACE_END(phandle, OLED_TRACE_REFRESH, status);
+  return status;
+#endif
+}
+
+OLED_StatusTypeDef OLED_Write_Pages(uint8_t *pdata, uint8_t page_start, uint8_t page_end)
+{
+  return OLEDH_Write_Pages(&g_oled_handle, pdata, page_start, page_end);
+}
+
+OLED_StatusTypeDef OLEDH_Refresh_Group(OLED_HandleTypeDef *const *phandles, uint8_t count)
+{
+  OLED_StatusTypeDef status = OLED_OK;
+#ifdef OLED_USING_DMA_TRANSMIT
+  uint32_t heads = 0;  // 每条总线队首的屏幕
+  if (count > 32) return OLED_ERROR;
+  for (uint8_t i = 0; i < count; ++i)
+    if (OLED_REFRESH_BUSY == phandles[i]->refresh_state) return OLED_BUSY;
+  // 先生成所有任务，之后就可以继续绘制下一帧
+  for (uint8_t i = 0; i < count; ++i) OLED_Async_Prepare(phandles[i]);
+  // 同一总线上的屏幕按数组顺序串成队列，队首的屏幕发送完后在中断里接着发送下一块
+  for (uint8_t i = 0; i < count; ++i) {
+    if (OLED_REFRESH_BUSY != phandles[i]->refresh_state) continue;
+    OLED_HandleTypeDef *ptail = NULL;
+    for (uint8_t j = 0; j < i && NULL == ptail; ++j)
+      if ((heads >> j & 1U) && phandles[j]->bus == phandles[i]->bus) ptail = phandles[j];
+    if (NULL == ptail) {
+      heads |= 1UL << i;
+      continue;
+    }
+    while (NULL != ptail->pnext) ptail = ptail->pnext;
+    ptail->pnext = phandles[i];
+  }
+  for (uint8_t i = 0; i < count; ++i)
+    if (heads >> i & 1U) OLED_Async_Step(phandles[i]);
+  for (uint8_t i = 0; i < count; ++i)
+    if (OLED_REFRESH_ERROR == phandles[i]->refresh_state) status = OLED_ERROR;
+#else
+  for (uint8_t i = 0; i < count; ++i)
+    if (OLED_OK != OLEDH_Refresh_GSRAM(phandles[i])) status = OLED_ERROR;
+#endif
   return status;
 }
 
@@ -61,39 +1054,61 @@ OLED_StatusTypeDef OLED_Refresh_GSRAM()
  */
 #define SET_BIT(REG, BIT) ((REG) |= (BIT))
 #define CLEAR_BIT(x, bit) (x &= ~(1 << bit)) /* 清零第bit位 */
-OLED_StatusTypeDef OLED_setPoint(uint8_t x, uint8_t y, uint8_t state)
+OLED_StatusTypeDef OLEDH_setPoint(OLED_HandleTypeDef *phandle, uint8_t x, uint8_t y, uint8_t state)
 {
   // 检查输入参数.超出范围自动返回错误
-  if (x >= OLED_PIX_WIDTH || y >= OLED_PIX_HEIGHT) return OLED_OUT_RANGE;
+  if (x >= OLEDH_WIDTH(phandle) || y >= OLEDH_HEIGHT(phandle)) return OLED_OUT_RANGE;
+  OLEDH_PHYS_POINT(phandle, x, y);
 
   uint8_t fill_data = y % 8;
-  uint8_t old_data = g_oled_buffer[(y - fill_data) / 8][x];
+  uint8_t *pdata = &OLED_PIXEL_ROW(phandle, y / 8)[x];
+  uint8_t old_data = *pdata;
   if (0 == state)
-    g_oled_buffer[(y - fill_data) / 8][x] = CLEAR_BIT(old_data, fill_data);
+    *pdata = CLEAR_BIT(old_data, fill_data);
   else
-    SET_BIT(g_oled_buffer[(y - fill_data) / 8][x], state << fill_data);
+    SET_BIT(*pdata, state << fill_data);
+  OLED_MARK_DIRTY_POINT(phandle, y / 8, x);
 
   return OLED_OK;
 }
 
+OLED_StatusTypeDef OLED_setPoint(uint8_t x, uint8_t y, uint8_t state)
+{
+  return OLEDH_setPoint(&g_oled_handle, x, y, state);
+}
+
+void OLEDH_Fill_Buffer(OLED_HandleTypeDef *phandle, uint8_t state)
+{
+  memset(phandle->pbuffer, state ? 0xff : 0x00, sizeof(uint8_t) * phandle->width * phandle->pages);
+  OLEDH_MARK_ALL_DIRTY(phandle);
+}
+
+void OLED_Fill_Buffer(uint8_t state) { OLEDH_Fill_Buffer(&g_oled_handle, state); }
+
+void OLEDH_Clear_Buffer(OLED_HandleTypeDef *phandle) { OLEDH_Fill_Buffer(phandle, 0x00); }
+
+void OLED_Clear_Buffer(void) { OLEDH_Clear_Buffer(&g_oled_handle); }
+
 /**
- * 将g_oled_buffer里面的内容更新到屏幕中
+ * 将显存里面的内容更新到屏幕中
  * @return OLED Status
  */
-OLED_StatusTypeDef OLED_Fill(uint8_t state)
+OLED_StatusTypeDef OLEDH_Fill(OLED_HandleTypeDef *phandle, uint8_t state)
 {
-  OLED_StatusTypeDef status;
-  memset(g_oled_buffer, state, sizeof(uint8_t) * OLED_PIX_WIDTH * OLED_PAGE_SIZE);
-  status = OLED_Refresh_GSRAM();
-  return status;
+  OLEDH_Fill_Buffer(phandle, state);
+  return OLEDH_Refresh_GSRAM(phandle);
 }
 
+OLED_StatusTypeDef OLED_Fill(uint8_t state) { return OLEDH_Fill(&g_oled_handle, state); }
+
 /**
  * 清屏
  * @note 执行此函数会立即将修改同步到屏幕当中
  * @return
  */
-OLED_StatusTypeDef OLED_Clear() { return OLED_Fill(0x00); }
+OLED_StatusTypeDef OLEDH_Clear(OLED_HandleTypeDef *phandle) { return OLEDH_Fill(phandle, 0x00); }
+
+OLED_StatusTypeDef OLED_Clear() { return OLEDH_Clear(&g_oled_handle); }
 
 /**
  * 字符串显示函数
@@ -103,15 +1118,16 @@ OLED_StatusTypeDef OLED_Clear() { return OLED_Fill(0x00); }
  * @param text_size 显示的大小
  * @return
  */
-OLED_StatusTypeDef OLED_ShowStr(uint8_t x, uint8_t y, uint8_t *pstr, uint8_t text_size)
+OLED_StatusTypeDef OLEDH_ShowStr(OLED_HandleTypeDef *phandle, uint8_t x, uint8_t y, uint8_t *pstr, uint8_t text_size)
 {
   uint8_t pstr_index = 0;
   uint8_t charter = 0;
   switch (text_size) {
     case 1:
       while (pstr[pstr_index] != '\0') {
-        charter = pstr[pstr_index] - 32;
-        if (x > OLED_PIX_WIDTH - 2) {
+        charter = pstr[pstr_index] - FONT_FIRST_CHAR;
+        if (charter >= F6X8_COUNT) charter = 0;  // 字库里没有的字符显示为空格
+        if (x > OLEDH_WIDTH(phandle) - 6) {
 #ifdef OLED_ENABLE_WRAP
           x = 0;
           y++;
@@ -119,15 +1135,22 @@ OLED_StatusTypeDef OLED_ShowStr(uint8_t x, uint8_t y, uint8_t *pstr, uint8_t tex
           return OLED_OUT_RANGE;
 #endif
         }
-        for (int i = 0; i < 6; ++i) g_oled_buffer[y][x + i] = F6x8[charter][i];
+        if (y >= (OLEDH_HEIGHT(phandle) + 7) / 8) return OLED_OUT_RANGE;
+#if OLED_SWAP_AXES
+        OLEDH_Draw_Bitmap(phandle, x, y * 8, 6, 8, F6x8[charter], OLED_ROP_COPY);
+#else
+        memcpy(&OLED_PIXEL_ROW(phandle, y)[x], F6x8[charter], 6);
+        OLEDH_MARK_DIRTY(phandle, x, x + 5, y, y);
+#endif
         x += 6;
         pstr_index++;
       }
       break;
     case 2:
       while (pstr[pstr_index] != '\0') {
-        charter = pstr[pstr_index] - 32;
-        if (x > OLED_PIX_WIDTH - 8) {
+        charter = pstr[pstr_index] - FONT_FIRST_CHAR;
+        if (charter >= F8X16_COUNT) charter = 0;
+        if (x > OLEDH_WIDTH(phandle) - 8) {
 #ifdef OLED_ENABLE_WRAP
           x = 0;
           y += 2;
@@ -135,40 +1158,348 @@ OLED_StatusTypeDef OLED_ShowStr(uint8_t x, uint8_t y, uint8_t *pstr, uint8_t tex
           return OLED_OUT_RANGE;
 #endif
         }
-        for (int i = 0; i < 8; ++i) g_oled_buffer[y][x + i] = F8X16[charter * 16 + i];
-        for (int i = 0; i < 8; ++i) g_oled_buffer[y + 1][x + i] = F8X16[charter * 16 + i + 8];
+        if (y + 1 >= (OLEDH_HEIGHT(phandle) + 7) / 8) return OLED_OUT_RANGE;
+#if OLED_SWAP_AXES
+        OLEDH_Draw_Bitmap(phandle, x, y * 8, 8, 16, &F8X16[charter * 16], OLED_ROP_COPY);
+#else
+        memcpy(&OLED_PIXEL_ROW(phandle, y)[x], &F8X16[charter * 16], 8);
+        memcpy(&OLED_PIXEL_ROW(phandle, y + 1)[x], &F8X16[charter * 16 + 8], 8);
+        OLEDH_MARK_DIRTY(phandle, x, x + 7, y, y + 1);
+#endif
         x += 8;
         pstr_index++;
       }
       break;
+    default: return OLED_ERROR;
   }
+  return OLED_OK;
 }
 
-OLED_StatusTypeDef OLED_ON() { return OLED_WriteCmd((uint8_t *)__oled_on_pararm, CALC_NUM_LENGTH(__oled_on_pararm)); }
+OLED_StatusTypeDef OLED_ShowStr(uint8_t x, uint8_t y, uint8_t *pstr, uint8_t text_size)
+{
+  return OLEDH_ShowStr(&g_oled_handle, x, y, pstr, text_size);
+}
+
+uint8_t OLEDH_Draw_Char(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t chr, uint8_t text_size,
+                        OLED_RopTypeDef rop)
+{
+  switch (text_size) {
+    case 1:
+      return OLEDH_Draw_Glyph(phandle, x, y, &g_oled_font_6x8, chr, rop);
+    case 2:
+      return OLEDH_Draw_Glyph(phandle, x, y, &g_oled_font_8x16, chr, rop);
+    default: return 0;
+  }
+}
+
+uint8_t OLED_Draw_Char(int16_t x, int16_t y, uint8_t chr, uint8_t text_size, OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_Char(&g_oled_handle, x, y, chr, text_size, rop);
+}
+
+uint16_t OLEDH_Draw_String(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const uint8_t *pstr, uint8_t text_size,
+                           OLED_RopTypeDef rop)
+{
+  uint16_t width = 0;
+  while ('\0' != *pstr && x + width < OLEDH_WIDTH(phandle)) {
+    uint8_t advance = OLEDH_Draw_Char(phandle, x + width, y, *pstr++, text_size, rop);
+    if (0 == advance) break;
+    width += advance;
+  }
+  return width;
+}
+
+uint16_t OLED_Draw_String(int16_t x, int16_t y, const uint8_t *pstr, uint8_t text_size, OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_String(&g_oled_handle, x, y, pstr, text_size, rop);
+}
+
+uint8_t OLEDH_Draw_Chinese(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t index, OLED_RopTypeDef rop)
+{
+  if (index < F16X16_COUNT)
+    OLEDH_Draw_Bitmap(phandle, x, y, 16, 16, &F16x16[index * 32], rop);
+  else
+    OLEDH_Draw_Rect(phandle, x + 1, y + 1, 14, 14, OLED_ROP_AND_NOT != rop);  // 与OLEDH_Draw_Glyph相同的缺字方框
+  return 16;
+}
+
+uint8_t OLED_Draw_Chinese(int16_t x, int16_t y, uint8_t index, OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_Chinese(&g_oled_handle, x, y, index, rop);
+}
+
+/**
+ * 立即发送开/关显示命令，并更新显示开关的缓存
+ * @param phandle 屏幕实例
+ * @param on 1开显示，0关显示
+ * @return OLED Status
+ */
+static OLED_StatusTypeDef OLED_Switch_Display(OLED_HandleTypeDef *phandle, uint8_t on)
+{
+  const OLED_ControllerTypeDef *pcontroller = phandle->pcontroller;
+  OLED_StatusTypeDef status = on ? OLEDH_WriteCmd(phandle, pcontroller->pon, pcontroller->on_length)
+                                 : OLEDH_WriteCmd(phandle, pcontroller->poff, pcontroller->off_length);
+  if (OLED_BUSY == status) return status;
+  phandle->regs_pending &= ~(1U << OLED_REG_DISPLAY);  // 暂存的显示开关被这次命令取代
+  if (OLED_OK != status) {
+    phandle->regs_known &= ~(1U << OLED_REG_DISPLAY);
+    return status;
+  }
+  phandle->regs[OLED_REG_DISPLAY] = on;
+  phandle->regs_known |= 1U << OLED_REG_DISPLAY;
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLEDH_ON(OLED_HandleTypeDef *phandle) { return OLED_Switch_Display(phandle, 1); }
+
+OLED_StatusTypeDef OLEDH_OFF(OLED_HandleTypeDef *phandle) { return OLED_Switch_Display(phandle, 0); }
+
+OLED_StatusTypeDef OLED_ON() { return OLEDH_ON(&g_oled_handle); }
+
+OLED_StatusTypeDef OLED_OFF() { return OLEDH_OFF(&g_oled_handle); }
+
+void OLEDH_Set_Register(OLED_HandleTypeDef *phandle, OLED_RegisterTypeDef reg, uint8_t value)
+{
+  if (reg >= OLED_REG_COUNT) return;
+  uint8_t bit = 1U << reg;
+  if (reg >= OLED_REG_ENTIRE_ON) value = 0 != value;
+  if ((phandle->regs_known & bit) && phandle->regs[reg] == value) {
+    phandle->regs_pending &= ~bit;  // 屏幕上已经是这个值，之前暂存的新值也不用发了
+    return;
+  }
+  phandle->regs_staged[reg] = value;
+  phandle->regs_pending |= bit;
+}
+
+void OLEDH_Set_Contrast(OLED_HandleTypeDef *phandle, uint8_t contrast)
+{
+  OLEDH_Set_Register(phandle, OLED_REG_CONTRAST, contrast);
+}
+
+void OLEDH_Set_Invert(OLED_HandleTypeDef *phandle, uint8_t invert)
+{
+  OLEDH_Set_Register(phandle, OLED_REG_INVERT, invert);
+}
+
+void OLEDH_Set_Display(OLED_HandleTypeDef *phandle, uint8_t on) { OLEDH_Set_Register(phandle, OLED_REG_DISPLAY, on); }
+
+OLED_StatusTypeDef OLEDH_Flush_Registers(OLED_HandleTypeDef *phandle)
+{
+  uint8_t cmd[OLED_REGISTER_CMD_MAX_LENGTH];
+  uint8_t mask;
+  if (0 == phandle->regs_pending) return OLED_OK;
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;  // 总线正在发送异步刷新
+#endif
+  uint8_t length = OLED_Take_Registers(phandle, cmd, &mask);
+  OLED_StatusTypeDef status = OLEDH_WriteCmd(phandle, cmd, length);
+  if (OLED_OK != status) OLED_Restore_Registers(phandle, mask);
+  return status;
+}
 
-OLED_StatusTypeDef OLED_OFF() { return OLED_WriteCmd((uint8_t *)__oled_off_param, CALC_NUM_LENGTH(__oled_off_param)); }
+void OLED_Set_Register(OLED_RegisterTypeDef reg, uint8_t value) { OLEDH_Set_Register(&g_oled_handle, reg, value); }
+
+void OLED_Set_Contrast(uint8_t contrast) { OLEDH_Set_Contrast(&g_oled_handle, contrast); }
+
+void OLED_Set_Invert(uint8_t invert) { OLEDH_Set_Invert(&g_oled_handle, invert); }
+
+void OLED_Set_Display(uint8_t on) { OLEDH_Set_Display(&g_oled_handle, on); }
+
+OLED_StatusTypeDef OLED_Flush_Registers(void) { return OLEDH_Flush_Registers(&g_oled_handle); }
+
+#ifdef OLED_USING_HARDWARE_SCROLL
+/**
+ * 显存整体纵向移动，露出的行清零
+ * @param pbuffer 显存
+ * @param width 列数
+ * @param pages 页数
+ * @param rows 内容上移的行数，为负时下移
+ */
+static void OLED_Shift_Rows(uint8_t *pbuffer, uint8_t width, uint8_t pages, int8_t rows)
+{
+  uint8_t distance = rows > 0 ? rows : -rows;
+  uint8_t skip = distance / 8, bits = distance % 8;
+  for (uint8_t i = 0; i < pages; ++i) {
+    // 上移时从上往下处理，下移时从下往上处理，读取的页总在写入的页之后
+    uint8_t page = rows > 0 ? i : pages - 1 - i;
+    uint8_t *prow = pbuffer + page * width;
+    int16_t near = rows > 0 ? page + skip : page - skip;
+    int16_t far = rows > 0 ? near + 1 : near - 1;
+    const uint8_t *pnear = near >= 0 && near < pages ? pbuffer + near * width : NULL;
+    const uint8_t *pfar = 0 != bits && far >= 0 && far < pages ? pbuffer + far * width : NULL;
+    for (uint8_t x = 0; x < width; ++x) {
+      uint8_t value = 0;
+      if (rows > 0) {
+        if (NULL != pnear) value = pnear[x] >> bits;
+        if (NULL != pfar) value |= pfar[x] << (8 - bits);
+      } else {
+        if (NULL != pnear) value = pnear[x] << bits;
+        if (NULL != pfar) value |= pfar[x] >> (8 - bits);
+      }
+      prow[x] = value;
+    }
+  }
+}
+
+#  ifdef OLED_USING_PARTIAL_REFRESH
+/**
+ * 翻转一段字节
+ * @param pstart 起始地址
+ * @param pend 结束地址(不含)
+ */
+static void OLED_Reverse_Bytes(uint8_t *pstart, uint8_t *pend)
+{
+  while (pstart + 1 < pend) {
+    uint8_t temp = *pstart;
+    *pstart++ = *--pend;
+    *pend = temp;
+  }
+}
+
+/**
+ * 原地循环左移，三次翻转实现，不需要额外的缓存
+ * @param parray 数组
+ * @param size 数组字节数
+ * @param step 左移的字节数
+ */
+static void OLED_Rotate_Bytes(uint8_t *parray, uint16_t size, uint16_t step)
+{
+  OLED_Reverse_Bytes(parray, parray + step);
+  OLED_Reverse_Bytes(parray + step, parray + size);
+  OLED_Reverse_Bytes(parray, parray + size);
+}
+#  endif
+
+/**
+ * 整屏纵向滚动
+ * @note 硬件滚动时GDDRAM中仍然有效的内容不再发送: 影子帧跟着显存一起按页轮转，脏区标记也一起轮转
+ * @param phandle 屏幕实例
+ * @param rows 内容上移的行数，为负时下移
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLEDH_Scroll(OLED_HandleTypeDef *phandle, int8_t rows)
+{
+#  ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;  // 正在发送的寻址命令依赖当前的起始行
+#  endif
+  if (0 == rows) return OLED_OK;
+  OLED_Shift_Rows(phandle->pbuffer, phandle->width, phandle->pages, rows);
+  uint8_t distance = rows > 0 ? rows : -rows;
+  if (0 != distance % 8 || OLED_GDDRAM_PAGES != phandle->pages || distance >= phandle->height) {
+#  ifndef OLED_USING_SHADOW_REFRESH
+    OLEDH_MARK_ALL_DIRTY(phandle);  // 影子帧比较时不需要标记，比较结果就是移动后变化的部分
+#  endif
+    return OLED_OK;
+  }
+  uint8_t pages = phandle->pages;
+  uint8_t step = rows > 0 ? distance / 8 : pages - distance / 8;  // 显存第0页对应的GDDRAM页前移的页数
+  phandle->scroll_page = (phandle->scroll_page + step) % pages;
+  phandle->scroll_pending = 1;
+#  ifdef OLED_USING_SHADOW_REFRESH
+  OLED_Rotate_Bytes(phandle->pshadow, phandle->width * pages, phandle->width * step);
+#  elif defined(OLED_USING_PARTIAL_REFRESH)
+  OLED_Rotate_Bytes(phandle->dirty_start, pages, step);
+  OLED_Rotate_Bytes(phandle->dirty_end, pages, step);
+  if (rows > 0)
+    OLEDH_Mark_Dirty(phandle, 0, phandle->width - 1, pages - distance / 8, pages - 1);
+  else
+    OLEDH_Mark_Dirty(phandle, 0, phandle->width - 1, 0, distance / 8 - 1);
+#  endif
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLED_Scroll(int8_t rows) { return OLEDH_Scroll(&g_oled_handle, rows); }
+
+OLED_StatusTypeDef OLEDH_Scroll_Horizontal_Start(OLED_HandleTypeDef *phandle, uint8_t left, uint8_t page_start,
+                                                 uint8_t page_end, uint8_t interval)
+{
+  if (!phandle->pcontroller->continuous_scroll || page_start > page_end || page_end >= phandle->pages)
+    return OLED_ERROR;
+  uint8_t ram_start = OLED_RAM_PAGE(phandle, page_start), ram_end = OLED_RAM_PAGE(phandle, page_end);
+  if (ram_start > ram_end) return OLED_ERROR;  // 页范围跨过了GDDRAM的回绕处，控制器无法滚动
+  uint8_t cmd[12];
+  uint8_t length = OLED_Take_Start_Line(phandle, cmd);
+  const uint8_t scroll[] = {0x2e, left ? 0x27 : 0x26, 0x00, ram_start, interval & 0x07, ram_end, 0x00};
+  memcpy(cmd + length, scroll, sizeof(scroll));
+  length += sizeof(scroll);
+  if (OLED_SCROLL_SSD1309 == phandle->pcontroller->continuous_scroll) {
+    // SSD1309的最后两个参数是滚动的GDDRAM列范围，与寻址命令一样由列偏移和旋转方向决定
+    cmd[length++] = phandle->ram_column;
+    cmd[length++] = phandle->ram_column + phandle->width - 1;
+  } else {
+    cmd[length++] = 0xff;
+  }
+  cmd[length++] = 0x2f;
+  return OLEDH_WriteCmd(phandle, cmd, length);
+}
+
+OLED_StatusTypeDef OLED_Scroll_Horizontal_Start(uint8_t left, uint8_t page_start, uint8_t page_end, uint8_t interval)
+{
+  return OLEDH_Scroll_Horizontal_Start(&g_oled_handle, left, page_start, page_end, interval);
+}
+
+OLED_StatusTypeDef OLEDH_Scroll_Horizontal_Stop(OLED_HandleTypeDef *phandle)
+{
+  const uint8_t cmd[] = {0x2e};
+  OLED_StatusTypeDef status = OLEDH_WriteCmd(phandle, cmd, CALC_NUM_LENGTH(cmd));
+  OLEDH_MARK_ALL_DIRTY(phandle);  // 滚动过的GDDRAM已经与显存、影子帧对不上
+  return status;
+}
+
+OLED_StatusTypeDef OLED_Scroll_Horizontal_Stop(void) { return OLEDH_Scroll_Horizontal_Stop(&g_oled_handle); }
+#endif
 
 /**
- * OLED 写命令函数，作用于仅限于本文件
+ * OLED 写命令函数
+ * @param phandle 屏幕实例
  * @param pcmd 命令数组指针
  * @param total 命令长度
  * @return OLED Status
  */
-OLED_StatusTypeDef OLED_WriteCmd(uint8_t *pcmd, uint16_t total)
+OLED_StatusTypeDef OLEDH_WriteCmd(OLED_HandleTypeDef *phandle, const uint8_t *pcmd, uint16_t total)
 {
-  OLED_WriteCmd_CallBefore();
-  /**
-   * @note 拷贝一份原有数据防止函数退出后，pcmd指向的地址失效
-   * @note 进而导致DMA发送数据异常
-   */
-  for (int i = 0; i < total; ++i) g_command_buffer[i] = pcmd[i];
-  OLED_StatusTypeDef status = OLED_Transmit(OLED_PHY_ADDRESS, 0x00, g_command_buffer, total, 0);
-  OLED_WriteCmd_CallAfter();
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;  // 总线正在发送异步刷新
+#endif
+  OLED_StatusTypeDef status = OLED_OK;
+  OLED_TRACE_BEGIN(phandle, OLED_TRACE_WRITE_CMD);
+#ifdef OLED_USING_SCATTER_GATHER
+  if (NULL != phandle->ptransport->transmit_list) {
+    const OLED_SegmentTypeDef segment = {pcmd, total, 0};  // 命令函数都是阻塞的，可以直接引用pcmd
+    OLED_TRACE_LIST_BEGIN(phandle, &segment, 1);
+    status = phandle->ptransport->transmit_list(phandle, &segment, 1);
+    OLED_TRACE_END(phandle, OLED_TRACE_LIST_TRANSFER, status);
+    total = 0;
+  }
+#endif
+  while (OLED_OK == status && total > 0) {
+    uint16_t size = total < OLED_COMMAND_BUFFER_LENGTH ? total : OLED_COMMAND_BUFFER_LENGTH;
+    OLED_TRACE_TRANSFER_BEGIN(phandle, 0, size);
+    OLED_TRANSPORT_BEFORE(phandle, 0);
+    /**
+     * @note 拷贝一份原有数据防止函数退出后，pcmd指向的地址失效
+     * @note 进而导致DMA发送数据异常
+     */
+    memcpy(phandle->cmd_buffer, pcmd, size);
+    status = phandle->ptransport->transmit(phandle, phandle->cmd_buffer, size, 0);
+    OLED_TRANSPORT_AFTER(phandle, 0);
+    OLED_TRACE_TRANSFER_END(phandle, 0, status);
+    pcmd += size;
+    total -= size;
+  }
+  OLED_TRACE_END(phandle, OLED_TRACE_WRITE_CMD, status);
   return status;
 }
 
+OLED_StatusTypeDef OLED_WriteCmd(uint8_t *pcmd, uint16_t total) { return OLEDH_WriteCmd(&g_oled_handle, pcmd, total); }
+
 __weak void OLED_Refresh_GSRAM_CallBefore() { return; }
 __weak void OLED_Refresh_GSRAM_CallAfter() { return; }
 
 __weak void OLED_WriteCmd_CallBefore() { return; }
-__weak void OLED_WriteCmd_CallAfter() { return; }
\ No newline at end of file
+__weak void OLED_WriteCmd_CallAfter() { return; }
+
+#ifdef OLED_USING_DMA_TRANSMIT
+__weak void OLED_Refresh_Async_CallComplete() { return; }
+__weak void OLED_Wait_Refresh_Idle() { return; }
+#endif
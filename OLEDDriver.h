@@ -12,6 +12,7 @@ extern "C" {
 #endif  // C++ Support
 #include <memory.h>
 #include <stdint.h>
+#include "OLEDTrace.h"
 
 #ifndef OLED_PHY_ADDRESS
 #  define OLED_PHY_ADDRESS 0x78  // I2C 物理地址
@@ -22,7 +23,41 @@ extern "C" {
 #ifndef OLED_PIX_HEIGHT
 #  define OLED_PIX_HEIGHT 64  // OLED屏幕纵向像素
 #endif
-#define OLED_PAGE_SIZE OLED_PIX_HEIGHT / 8  // OLED驱动存储页数
+#define OLED_PAGE_SIZE ((OLED_PIX_HEIGHT + 7) / 8)  // OLED驱动存储页数
+#ifndef OLED_COLUMN_OFFSET
+#  define OLED_COLUMN_OFFSET 0  // 默认实例的额外列偏移，加在控制器的列偏移上
+#endif
+#ifndef OLED_COM_PINS
+#  define OLED_COM_PINS 0  // 默认实例的COM引脚配置(0xda的参数)，为0时按分辨率选择
+#endif
+#ifndef OLED_ROTATION
+#  define OLED_ROTATION 0  // 画面旋转角度(顺时针)，作用于所有实例
+#endif
+#if OLED_ROTATION != 0 && OLED_ROTATION != 90 && OLED_ROTATION != 180 && OLED_ROTATION != 270
+#  error "OLED_ROTATION只能是0、90、180、270"
+#endif
+#ifndef OLED_MAX_PAGE_SIZE
+#  define OLED_MAX_PAGE_SIZE 8  // 多实例时单块屏幕最多的页数，用于分配每个实例的脏区表
+#endif
+#ifndef OLED_COMMAND_BUFFER_LENGTH
+#  define OLED_COMMAND_BUFFER_LENGTH 32  // OLED 命令存储Buffer长度
+#endif
+#ifndef OLED_REFRESH_MAX_SPANS
+#  define OLED_REFRESH_MAX_SPANS 32  // 局部刷新一次最多发送的区间数，超出后整屏发送
+#endif
+#ifndef OLED_SEGMENT_LIST_LENGTH
+#  define OLED_SEGMENT_LIST_LENGTH 16  // 分段传输一次提交的最大段数，页寻址的整帧为2 * 页数段
+#endif
+#ifdef OLED_USING_HARDWARE_SCROLL
+#  define OLED_ADDRESS_CMD_MAX_LENGTH 7  // 一次寻址命令的最大长度，含滚动后附带的起始行命令
+#else
+#  define OLED_ADDRESS_CMD_MAX_LENGTH 6  // 一次寻址命令的最大长度
+#endif
+#define OLED_REGISTER_CMD_MAX_LENGTH 9  // 所有暂存的寄存器设置一起发送时的最大命令长度
+#if (defined(OLED_USING_SHADOW_REFRESH) || defined(OLED_USING_DMA_TRANSMIT) || defined(OLED_USING_SCATTER_GATHER)) && \
+    !defined(OLED_USING_PARTIAL_REFRESH)
+#  define OLED_USING_PARTIAL_REFRESH  // 影子帧比较、异步刷新与分段传输都依赖局部刷新的寻址流程
+#endif
 
 /**
  * @brief 定义返回常量，方便调试的时候判断状态
@@ -31,14 +66,284 @@ typedef enum {
   OLED_OK = 0x00U,
   OLED_ERROR = 0x01U,
   OLED_OUT_RANGE = 0x02U,
+  OLED_BUSY = 0x03U,
 } OLED_StatusTypeDef;
 
+/**
+ * @brief 位图/字符写入缓存时的光栅操作
+ */
+typedef enum {
+  OLED_ROP_COPY = 0x00U,     // 覆盖，位图范围内的点全部替换
+  OLED_ROP_OR = 0x01U,       // 叠加，只点亮位图中为1的点
+  OLED_ROP_AND_NOT = 0x02U,  // 擦除，熄灭位图中为1的点
+  OLED_ROP_XOR = 0x03U,      // 反转位图中为1的点
+} OLED_RopTypeDef;
+
+/**
+ * @brief 可以暂存、合并发送的控制器设置，参数相同时不重复发送
+ */
+typedef enum {
+  OLED_REG_CONTRAST = 0x00U,   // 对比度 0x81 xx
+  OLED_REG_PRECHARGE = 0x01U,  // 预充电周期 0xd9 xx
+  OLED_REG_VCOMH = 0x02U,      // VCOMH电压 0xdb xx
+  OLED_REG_ENTIRE_ON = 0x03U,  // 全屏点亮 0xa4/0xa5
+  OLED_REG_INVERT = 0x04U,     // 反色 0xa6/0xa7
+  OLED_REG_DISPLAY = 0x05U,    // 显示开关 0xae/0xaf，不开关电荷泵
+  OLED_REG_COUNT = 0x06U,
+} OLED_RegisterTypeDef;
+
+#ifdef OLED_USING_DMA_TRANSMIT
+/**
+ * @brief 异步刷新状态
+ */
+typedef enum {
+  OLED_REFRESH_IDLE = 0x00U,   // 空闲，可以开始下一次刷新
+  OLED_REFRESH_BUSY = 0x01U,   // 正在发送
+  OLED_REFRESH_ERROR = 0x02U,  // 上一次刷新传输出错，下一次刷新会整屏发送
+} OLED_RefreshStateTypeDef;
+#endif
+
+typedef struct OLED_HandleTypeDef OLED_HandleTypeDef;
+
+#ifdef OLED_USING_SCATTER_GATHER
+/**
+ * @brief 分段传输中的一段，直接引用Flash中的命令表或显存，驱动不做拷贝
+ * @note 一段的数据在整个列表发送完成之前不能被修改
+ */
+typedef struct {
+  const uint8_t *pdata;  // 数据指针
+  uint16_t size;         // 数据长度
+  uint8_t mode;          // 0->命令;1->数据，I2C下对应控制字节0x00/0x40，SPI下对应DC引脚
+} OLED_SegmentTypeDef;
+#endif
+
+/**
+ * @brief 传输函数表，每个实例可以接在不同的总线上
+ * @note mode 0->命令;1->数据
+ */
+typedef struct {
+  OLED_StatusTypeDef (*transmit)(OLED_HandleTypeDef *phandle, uint8_t *pData, uint16_t Size, uint8_t mode);
+  void (*before)(OLED_HandleTypeDef *phandle, uint8_t mode);  // 每次传输之前调用，可为NULL，SPI可在此切换DC、片选
+  void (*after)(OLED_HandleTypeDef *phandle, uint8_t mode);   // 每次传输之后调用，可为NULL
+  void (*complete)(OLED_HandleTypeDef *phandle);              // 异步刷新完成后在中断里调用，可为NULL
+#ifdef OLED_USING_SCATTER_GATHER
+  /**
+   * 一次提交一组分段，例如串成一条链式DMA或者一次I2C传输(段之间用重复起始)，可为NULL，此时逐段调用transmit
+   * @note 提交列表时不调用before/after，由传输函数根据每一段的mode自行切换；返回时机与transmit相同，
+   *       异步刷新时整组发送完成后调用一次OLEDH_Transmit_Done，其余情况下需要发送完成后再返回
+   */
+  OLED_StatusTypeDef (*transmit_list)(OLED_HandleTypeDef *phandle, const OLED_SegmentTypeDef *psegments,
+                                      uint16_t count);
+#endif
+} OLED_TransportTypeDef;
+
+#define OLED_SCROLL_NONE 0x00U    // 不支持连续水平滚动
+#define OLED_SCROLL_SSD1306 0x01U  // 结束页之后为0x00、0xff
+#define OLED_SCROLL_SSD1309 0x02U  // 结束页之后为0x00、起始列、结束列
+
+/**
+ * @brief 控制器描述表，OLEDH_Init按实例的pcontroller发送初始化命令，刷新时按寻址能力选择发送方式
+ * @note 支持水平寻址的芯片设置窗口后一次发完整行宽度的区域，只能页寻址的芯片逐页寻址并加上列偏移
+ */
+typedef struct {
+  const char *name;           // 芯片名称
+  const uint8_t *pinit;       // 初始化命令，不含多路复用比、COM引脚、扫描方向、寻址模式与开显示，由驱动补发
+  uint16_t init_length;       // 初始化命令长度
+  const uint8_t *pon;         // 开显示命令
+  uint8_t on_length;          // 开显示命令长度
+  const uint8_t *poff;        // 关显示命令
+  uint8_t off_length;         // 关显示命令长度
+  uint8_t ram_width;          // GDDRAM列数
+  uint8_t column_offset;      // 屏幕第0列对应的GDDRAM列
+  uint8_t horizontal;         // 支持水平寻址(0x20)与窗口设置(0x21/0x22)
+  uint8_t continuous_scroll;  // 连续水平滚动(0x26/0x27)的参数格式，OLED_SCROLL_NONE为不支持
+  uint16_t max_transfer;      // 一次数据传输的最大字节数，0为不限制
+} OLED_ControllerTypeDef;
+
+extern const OLED_ControllerTypeDef g_oled_ssd1306;  // 128列，水平寻址
+extern const OLED_ControllerTypeDef g_oled_sh1106;   // 132列，只有页寻址，128列的屏幕居中偏移两列
+extern const OLED_ControllerTypeDef g_oled_ssd1309;  // 128列，水平寻址，外部供电没有电荷泵
+extern const OLED_ControllerTypeDef g_oled_ssd1315;  // 128列，水平寻址，命令与SSD1306兼容
+
+#ifdef OLED_USING_PARTIAL_REFRESH
+/**
+ * @brief 一个需要发送的矩形区域，列[x_start, x_end]，页[page_start, page_end]
+ */
+typedef struct {
+  uint8_t x_start;
+  uint8_t x_end;
+  uint8_t page_start;
+  uint8_t page_end;
+} OLED_WindowTypeDef;
+
+/**
+ * @brief 一次刷新任务，按步骤依次发出寻址命令与显示数据，驱动内部使用
+ * @brief 异步刷新时在传输完成中断里取出下一步，所以寻址命令也保存在这里
+ */
+typedef struct {
+  uint8_t *pframe;                                    // 发送的数据来源
+  uint8_t frame_page;                                 // pframe第一行所在的页，发送整帧时为0
+  OLED_WindowTypeDef windows[OLED_REFRESH_MAX_SPANS];  // 需要发送的区域
+  uint8_t count;                                      // 区域个数
+  uint8_t index;                                      // 正在发送的区域
+  uint8_t page;                                       // 正在发送的页
+  uint8_t phase;                                      // 0:寻址 1:数据
+  uint16_t offset;                                    // 一段数据超过max_transfer时已经发出的字节数
+  uint8_t cmd[OLED_ADDRESS_CMD_MAX_LENGTH];           // 寻址命令
+  // 第一条寻址命令，前面带上暂存的寄存器设置，在OLED_Job_Prepare中生成，发送时不再读取实例的暂存值
+  uint8_t regs_cmd[OLED_REGISTER_CMD_MAX_LENGTH + OLED_ADDRESS_CMD_MAX_LENGTH];
+  uint8_t regs_length;  // regs_cmd中寄存器设置的长度，发出后清零
+  uint8_t regs_mask;    // 这次任务带上的寄存器，任务出错时在下一次刷新重新发送
+#  ifdef OLED_USING_SCATTER_GATHER
+  OLED_SegmentTypeDef segments[OLED_SEGMENT_LIST_LENGTH];  // 正在提交的分段列表
+  // 列表中的寻址命令，每条寻址命令后面至少跟一段数据，所以最多占一半
+  uint8_t cmds[(OLED_SEGMENT_LIST_LENGTH + 1) / 2][OLED_ADDRESS_CMD_MAX_LENGTH];
+#  endif
+} OLED_RefreshJobTypeDef;
+#endif
+
+/**
+ * @brief 一块屏幕的实例
+ * @note 调用OLEDH_Init之前填写用户配置部分，其余为驱动内部状态
+ */
+struct OLED_HandleTypeDef {
+  uint8_t *pbuffer;                           // 显存，按页存储，一页width字节，共(height + 7) / 8页
+  uint8_t width;                              // 横向像素，按屏幕原始方向，不随OLED_ROTATION交换
+  uint8_t height;                             // 纵向像素，不超过OLED_MAX_PAGE_SIZE * 8
+  uint8_t column_offset;                      // 额外的列偏移，加在控制器的column_offset上，例如72x40接SSD1306时为28
+  uint8_t com_pins;                           // COM引脚配置(0xda的参数)，为0时按OLED_DEFAULT_COM_PINS选择
+  uint16_t address;                           // I2C物理地址
+  uint8_t bus;                                // 总线编号，OLEDH_Refresh_Group中同一总线上的屏幕依次发送
+  const OLED_TransportTypeDef *ptransport;    // 传输函数表
+  const OLED_ControllerTypeDef *pcontroller;  // 控制器，为NULL时OLEDH_Init使用编译时选择的默认芯片
+  void *puser;                                // 用户数据，例如I2C句柄或片选引脚，驱动不使用
+#ifdef OLED_USING_TRACE
+  OLED_TraceTypeDef *ptrace;  // 性能统计，为NULL时不统计
+#endif
+#ifdef OLED_USING_SHADOW_REFRESH
+  uint8_t *pshadow;  // 影子帧，大小与pbuffer相同
+#elif defined(OLED_USING_DMA_TRANSMIT)
+  uint8_t *ptx;  // 异步刷新的发送缓存，大小与pbuffer相同
+#endif
+
+  uint8_t pages;                                   // 页数
+  uint8_t ram_column;                              // 显存第0列对应的GDDRAM列，由列偏移与旋转方向决定
+#ifdef OLED_USING_HARDWARE_SCROLL
+  uint8_t scroll_page;     // 显存第0页写入的GDDRAM页，GDDRAM作为环形缓冲，起始行为scroll_page * 8
+  uint8_t scroll_pending;  // 起始行命令还没有发送，随下一次刷新的第一条寻址命令发出
+#endif
+  uint8_t cmd_buffer[OLED_COMMAND_BUFFER_LENGTH];  // 命令缓存
+  uint8_t regs[OLED_REG_COUNT];                    // 屏幕上的寄存器值，regs_known中对应位为1时有效
+  uint8_t regs_staged[OLED_REG_COUNT];             // 暂存的寄存器新值
+  uint8_t regs_known;                              // 屏幕上的值已知的寄存器
+  uint8_t regs_pending;                            // 暂存了新值、等待发送的寄存器
+#ifdef OLED_USING_PARTIAL_REFRESH
+  uint8_t dirty_start[OLED_MAX_PAGE_SIZE];  // 每一页的脏区列范围[start, end]，start > end 表示该页无改动
+  uint8_t dirty_end[OLED_MAX_PAGE_SIZE];
+  uint8_t refresh_all;         // 置位时下一次刷新整屏推送
+  OLED_RefreshJobTypeDef job;  // 刷新任务
+#endif
+#ifdef OLED_USING_DMA_TRANSMIT
+  volatile OLED_RefreshStateTypeDef refresh_state;  // 异步刷新状态
+  uint8_t async_mode;                               // 正在进行的传输模式
+  OLED_HandleTypeDef *pnext;                        // 同一总线上排队等这块屏幕发送完的下一块屏幕
+#endif
+};
+
+/**
+ * @brief 常见模组的COM引脚接法: 宽度不小于96的16/32行模组顺序连接(0x02)，其余交替连接(0x12)
+ */
+#define OLED_DEFAULT_COM_PINS(width, height) ((height) <= 32 && (width) >= 96 ? 0x02 : 0x12)
+
+/**
+ * @brief 绘图坐标系，OLED_ROTATION为90/270时与显存的行列互换
+ * @note 所有绘图函数都使用绘图坐标，进入函数时按编译时的旋转方向一次换算成显存坐标，逐点绘制时不再换算
+ * @note 180度由控制器的段/COM重映射完成，显存与绘图坐标相同，不占用CPU
+ */
+#if OLED_ROTATION == 90 || OLED_ROTATION == 270
+#  define OLED_SWAP_AXES 1
+#  define OLEDH_WIDTH(phandle) ((phandle)->height)  // 绘图坐标系的宽度
+#  define OLEDH_HEIGHT(phandle) ((phandle)->width)  // 绘图坐标系的高度
+#else
+#  define OLED_SWAP_AXES 0
+#  define OLEDH_WIDTH(phandle) ((phandle)->width)
+#  define OLEDH_HEIGHT(phandle) ((phandle)->height)
+#endif
+#if OLED_ROTATION == 90
+#  define OLEDH_PHYS_X(phandle, x, y) ((phandle)->width - 1 - (y))  // 绘图坐标对应的显存列
+#  define OLEDH_PHYS_Y(phandle, x, y) (x)                           // 绘图坐标对应的显存行
+#  define OLED_PHYS_ROW_STEP (-1)                                   // 绘图坐标下移一行时显存列的增量
+#elif OLED_ROTATION == 270
+#  define OLEDH_PHYS_X(phandle, x, y) (y)
+#  define OLEDH_PHYS_Y(phandle, x, y) ((phandle)->height - 1 - (x))
+#  define OLED_PHYS_ROW_STEP 1
+#else
+#  define OLEDH_PHYS_X(phandle, x, y) (x)
+#  define OLEDH_PHYS_Y(phandle, x, y) (y)
+#endif
+
+/**
+ * @brief 把绘图坐标系中的一个点原地换算成显存坐标，参数都必须是变量
+ */
+#if OLED_SWAP_AXES
+#  define OLEDH_PHYS_POINT(phandle, x, y)           \
+    do {                                            \
+      int16_t phys_x = OLEDH_PHYS_X(phandle, x, y); \
+      y = OLEDH_PHYS_Y(phandle, x, y);              \
+      x = phys_x;                                   \
+    } while (0)
+#else
+#  define OLEDH_PHYS_POINT(phandle, x, y)
+#endif
+
+/**
+ * @brief 把绘图坐标系中的矩形(左上角与宽高)原地换算成显存中的矩形，参数都必须是int16_t变量
+ */
+#if OLED_ROTATION == 90
+#  define OLEDH_PHYS_RECT(phandle, x, y, w, h) \
+    do {                                       \
+      int16_t swap = w;                        \
+      w = h;                                   \
+      h = swap;                                \
+      swap = x;                                \
+      x = (phandle)->width - (y) - (w);        \
+      y = swap;                                \
+    } while (0)
+#elif OLED_ROTATION == 270
+#  define OLEDH_PHYS_RECT(phandle, x, y, w, h) \
+    do {                                       \
+      int16_t swap = w;                        \
+      w = h;                                   \
+      h = swap;                                \
+      swap = y;                                \
+      y = (phandle)->height - (x) - (h);       \
+      x = swap;                                \
+    } while (0)
+#else
+#  define OLEDH_PHYS_RECT(phandle, x, y, w, h)
+#endif
+
 /**
  * @brief 使用二维数组存储像素，相当于是画布
  * @brief 所有对其的修改都不会立即同步到OLED上面
  * @brief 需要调用刷新函数
+ * @note 定义OLED_USING_STRIP_RENDER时不分配显存与影子帧/发送缓存，默认实例的pbuffer为NULL，只能分条渲染或直接写入GDDRAM
  */
+#ifndef OLED_USING_STRIP_RENDER
 extern uint8_t g_oled_buffer[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+#endif
+
+/**
+ * @brief 默认实例，使用g_oled_buffer、OLED_PHY_ADDRESS与OLED_Transmit
+ * @brief 不带句柄的函数都作用于默认实例
+ */
+extern OLED_HandleTypeDef g_oled_handle;
+
+/**
+ * @brief 通过OLED_Transmit与各个钩子函数传输的函数表
+ * @note 多块屏幕接在同一条I2C总线上时可以共用，OLED_Transmit按DevAddress区分
+ */
+extern const OLED_TransportTypeDef g_oled_default_transport;
 
 /**
  * OLED初始化函数
@@ -59,10 +364,70 @@ OLED_StatusTypeDef OLED_Transmit(uint16_t DevAddress, uint16_t MemAddress, uint8
 
 /**
  * 将g_oled_buffer里面的内容更新到屏幕中
+ * @note 定义OLED_USING_PARTIAL_REFRESH后只发送改动过的区域，寻址命令由驱动自行发送
+ * @note 定义OLED_USING_SHADOW_REFRESH后与上一次发送的帧比较得到改动区域，直接修改g_oled_buffer也无需手动标记
  * @return OLED Status
  */
 OLED_StatusTypeDef OLED_Refresh_GSRAM();
 
+#ifdef OLED_USING_PARTIAL_REFRESH
+/**
+ * 标记一块区域需要刷新
+ * @note 绘图函数会自动标记，直接修改g_oled_buffer时需要手动调用
+ * @param x_start 起始列
+ * @param x_end 结束列(包含)
+ * @param page_start 起始页
+ * @param page_end 结束页(包含)
+ */
+void OLED_Mark_Dirty(uint8_t x_start, uint8_t x_end, uint8_t page_start, uint8_t page_end);
+
+/**
+ * 标记整屏需要刷新，下一次刷新会推送完整的一帧
+ */
+void OLED_Mark_All_Dirty(void);
+void OLEDH_Mark_Dirty(OLED_HandleTypeDef *phandle, uint8_t x_start, uint8_t x_end, uint8_t page_start,
+                      uint8_t page_end);
+void OLEDH_Mark_All_Dirty(OLED_HandleTypeDef *phandle);
+#  define OLEDH_MARK_DIRTY(phandle, x_start, x_end, page_start, page_end) \
+    OLEDH_Mark_Dirty(phandle, x_start, x_end, page_start, page_end)
+#  define OLEDH_MARK_ALL_DIRTY(phandle) OLEDH_Mark_All_Dirty(phandle)
+#else
+#  define OLEDH_MARK_DIRTY(phandle, x_start, x_end, page_start, page_end)
+#  define OLEDH_MARK_ALL_DIRTY(phandle)
+#endif
+#define OLED_MARK_DIRTY(x_start, x_end, page_start, page_end) \
+  OLEDH_MARK_DIRTY(&g_oled_handle, x_start, x_end, page_start, page_end)
+#define OLED_MARK_ALL_DIRTY() OLEDH_MARK_ALL_DIRTY(&g_oled_handle)
+
+#ifdef OLED_USING_DMA_TRANSMIT
+/**
+ * 异步刷新，把改动区域拷贝出来后发出第一段传输立即返回
+ * @note 返回后即可继续修改g_oled_buffer绘制下一帧，这些改动留给下一次刷新
+ * @note OLED_Transmit只负责启动传输，传输完成后需要在中断里调用OLED_Transmit_Done
+ * @return 上一次刷新还没完成时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Refresh_Async(void);
+
+/**
+ * 通知驱动一次OLED_Transmit传输已经结束，驱动会接着发出下一段寻址命令或数据
+ * @note 在DMA传输完成(或出错)中断里调用，例如HAL_SPI_TxCpltCallback
+ * @param status 传输结果
+ */
+void OLED_Transmit_Done(OLED_StatusTypeDef status);
+
+/**
+ * 查询异步刷新状态
+ * @return 异步刷新状态
+ */
+OLED_RefreshStateTypeDef OLED_Get_Refresh_State(void);
+
+/**
+ * 等待异步刷新完成，等待期间反复调用OLED_Wait_Refresh_Idle
+ * @return 刷新出错时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Wait_Refresh(void);
+#endif
+
 /**
  * 点亮某一个点或者点灭某一个点
  * @param x 横坐标 0~横向像素 - 1
@@ -87,6 +452,17 @@ OLED_StatusTypeDef OLED_Fill(uint8_t state);
  */
 OLED_StatusTypeDef OLED_Clear();
 
+/**
+ * 只填充显存并标记整屏需要刷新，不发送
+ * @param state 0是清屏,1是点亮
+ */
+void OLED_Fill_Buffer(uint8_t state);
+
+/**
+ * 只清空显存并标记整屏需要刷新，不发送
+ */
+void OLED_Clear_Buffer(void);
+
 /**
  * 字符串显示函数
  * @param x 横坐标 0 ~ 横向像素 - 1
@@ -97,15 +473,230 @@ OLED_StatusTypeDef OLED_Clear();
  */
 OLED_StatusTypeDef OLED_ShowStr(uint8_t x, uint8_t y, uint8_t *pstr, uint8_t text_size);
 
+/**
+ * 在任意像素位置绘制一个字符
+ * @note 纵坐标不需要按页对齐，超出屏幕的部分被裁剪
+ * @param x 横坐标，可以为负
+ * @param y 纵坐标(像素)，可以为负
+ * @param chr 字符
+ * @param text_size 1为6x8，2为8x16
+ * @param rop 光栅操作
+ * @return 字符宽度，text_size无效时返回0
+ */
+uint8_t OLED_Draw_Char(int16_t x, int16_t y, uint8_t chr, uint8_t text_size, OLED_RopTypeDef rop);
+
+/**
+ * 在任意像素位置绘制字符串，超出屏幕右边缘后停止
+ * @param x 横坐标，可以为负
+ * @param y 纵坐标(像素)，可以为负
+ * @param pstr 字符串指针
+ * @param text_size 1为6x8，2为8x16
+ * @param rop 光栅操作
+ * @return 绘制的总宽度
+ */
+uint16_t OLED_Draw_String(int16_t x, int16_t y, const uint8_t *pstr, uint8_t text_size, OLED_RopTypeDef rop);
+
+/**
+ * 在任意像素位置绘制一个16x16汉字
+ * @note 序号超出F16x16时与OLED_Draw_Glyph一样绘制一个空心方框，宽度仍为16
+ * @param x 横坐标，可以为负
+ * @param y 纵坐标(像素)，可以为负
+ * @param index 汉字在F16x16中的序号
+ * @param rop 光栅操作
+ * @return 字符宽度
+ */
+uint8_t OLED_Draw_Chinese(int16_t x, int16_t y, uint8_t index, OLED_RopTypeDef rop);
+
 OLED_StatusTypeDef OLED_ON();
 OLED_StatusTypeDef OLED_OFF();
 
+/**
+ * 暂存一项控制器设置，不立即发送，随下一次刷新的第一条寻址命令或OLED_Flush_Registers一起发出
+ * @note 与屏幕上已知的值相同时不发送，并撤销之前暂存的新值；同一项多次设置只发送最后一次
+ * @note 需要与刷新函数在同一个上下文中调用，不能在中断里调用
+ * @param reg 寄存器
+ * @param value 参数，OLED_REG_ENTIRE_ON/INVERT/DISPLAY非0为开启
+ */
+void OLED_Set_Register(OLED_RegisterTypeDef reg, uint8_t value);
+
+/**
+ * 暂存对比度，同OLED_Set_Register(OLED_REG_CONTRAST, contrast)
+ * @param contrast 对比度 0~255
+ */
+void OLED_Set_Contrast(uint8_t contrast);
+
+/**
+ * 暂存反色显示
+ * @param invert 1反色，0正常
+ */
+void OLED_Set_Invert(uint8_t invert);
+
+/**
+ * 暂存显示开关，只发送0xae/0xaf，不开关电荷泵，适合短时间熄屏
+ * @note OLED_ON/OLED_OFF会立即发送并同时开关电荷泵，发送后更新这一项的缓存
+ * @param on 1开显示，0关显示
+ */
+void OLED_Set_Display(uint8_t on);
+
+/**
+ * 不等刷新，把暂存的设置合并成一次命令传输立即发出
+ * @return 没有暂存的设置时直接返回OLED_OK，异步刷新正在进行时返回OLED_BUSY，出错时设置保留到下一次发送
+ */
+OLED_StatusTypeDef OLED_Flush_Registers(void);
+
+#ifdef OLED_USING_HARDWARE_SCROLL
+/**
+ * 整屏纵向滚动，g_oled_buffer中的内容同步移动，露出的行清零，之后可以直接在露出的行上绘制
+ * @note rows为8的倍数且屏幕为64行时把GDDRAM当作环形缓冲，只修改显示起始行，下一次刷新只发送露出的行和一条命令
+ * @note 其它情况在显存中移动后整屏刷新
+ * @param rows 内容上移的行数，为负时下移
+ * @return 异步刷新正在进行时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Scroll(int8_t rows);
+
+/**
+ * 开始连续水平滚动，滚动由控制器完成，不占用总线
+ * @note 滚动期间不要刷新，停止后GDDRAM的内容需要重新写入
+ * @param left 1向左滚动，0向右滚动
+ * @param page_start 起始页
+ * @param page_end 结束页
+ * @param interval 滚动间隔(帧)的编码: 0->5 1->64 2->128 3->256 4->3 5->4 6->25 7->2
+ * @return 控制器不支持或页范围无效时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Scroll_Horizontal_Start(uint8_t left, uint8_t page_start, uint8_t page_end, uint8_t interval);
+
+/**
+ * 停止连续水平滚动，标记整屏需要刷新
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Scroll_Horizontal_Stop(void);
+#endif
+
+/**
+ * OLED 写命令函数
+ * @param pcmd 命令数组指针
+ * @param total 命令长度
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_WriteCmd(uint8_t *pcmd, uint16_t total);
+
+/**
+ * 设置GDDRAM的写入窗口，之后用OLED_Write_Data直接写入，不经过显存
+ * @note 页寻址时只设置起始页和起始列，x_end与page_end不起作用，写满一页不会换页
+ * @note 直接写入后屏幕与显存不一致，重新使用显存刷新前需要调用OLED_MARK_ALL_DIRTY()
+ * @param x_start 起始列
+ * @param x_end 结束列(包含)
+ * @param page_start 起始页
+ * @param page_end 结束页(包含)
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Set_Window(uint8_t x_start, uint8_t x_end, uint8_t page_start, uint8_t page_end);
+
+/**
+ * 向GDDRAM写入显示数据，超过控制器的max_transfer时分多次发送
+ * @note 只适用于阻塞的传输函数，异步传输时pdata在函数返回后仍然会被读取
+ * @param pdata 数据指针
+ * @param size 数据长度
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Write_Data(uint8_t *pdata, uint16_t size);
+
+/**
+ * 把一段按页存储的数据写到屏幕的[page_start, page_end]页，整行宽度，不经过显存
+ * @note 数据格式与显存相同，第一个字节对应page_start页的第0列，共width * (page_end - page_start + 1)字节
+ * @note 与刷新共用寻址流程，超过max_transfer时分段、暂存的寄存器设置随寻址命令发出，分段传输时一次提交
+ * @note 定义OLED_USING_DMA_TRANSMIT时发出第一段传输后立即返回，发送完成前pdata不能修改，用OLED_Wait_Refresh等待
+ * @note 写入后屏幕与显存不一致，会标记整屏需要刷新
+ * @param pdata 数据指针
+ * @param page_start 起始页
+ * @param page_end 结束页(包含)
+ * @return 页号超出屏幕时返回OLED_OUT_RANGE，上一次异步发送还没完成时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Write_Pages(uint8_t *pdata, uint8_t page_start, uint8_t page_end);
+
+/**
+ * @brief 多实例接口，第一个参数为屏幕实例，其余参数与返回值同上面不带句柄的同名函数
+ */
+
+/**
+ * 初始化一块屏幕，根据height计算页数，清空脏区并发送控制器的初始化命令
+ * @note 初始化命令之后按分辨率补发多路复用比(height - 1)与COM引脚配置，按OLED_ROTATION补发段/COM扫描方向，最后开显示
+ * @param phandle 屏幕实例，用户配置部分需要事先填写
+ * @return 配置无效或屏幕宽度超出控制器GDDRAM时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLEDH_Init(OLED_HandleTypeDef *phandle);
+
+/**
+ * 向一块屏幕发送命令，超过OLED_COMMAND_BUFFER_LENGTH的命令分多次发送
+ * @note 定义OLED_USING_SCATTER_GATHER且传输函数表提供transmit_list时直接引用pcmd一次发完，不经过命令缓存
+ * @param phandle 屏幕实例
+ * @param pcmd 命令数组指针
+ * @param total 命令长度
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLEDH_WriteCmd(OLED_HandleTypeDef *phandle, const uint8_t *pcmd, uint16_t total);
+OLED_StatusTypeDef OLEDH_Set_Window(OLED_HandleTypeDef *phandle, uint8_t x_start, uint8_t x_end, uint8_t page_start,
+                                    uint8_t page_end);
+OLED_StatusTypeDef OLEDH_Write_Data(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint16_t size);
+OLED_StatusTypeDef OLEDH_Write_Pages(OLED_HandleTypeDef *phandle, uint8_t *pdata, uint8_t page_start,
+                                     uint8_t page_end);
+
+OLED_StatusTypeDef OLEDH_Refresh_GSRAM(OLED_HandleTypeDef *phandle);
+
+/**
+ * 刷新多块屏幕
+ * @note 定义OLED_USING_DMA_TRANSMIT时先把每块屏幕的改动区域拷贝出来，不同bus的屏幕同时开始异步发送，
+ *       同一bus上的屏幕排成队列，前一块发送完成后在中断里接着发送下一块，函数立即返回，用OLEDH_Wait_Refresh等待
+ * @note 未定义OLED_USING_DMA_TRANSMIT时依次阻塞刷新
+ * @param phandles 屏幕实例数组
+ * @param count 屏幕个数
+ * @return 有屏幕正在异步刷新时返回OLED_BUSY且不做任何事，有屏幕出错或超过32块时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLEDH_Refresh_Group(OLED_HandleTypeDef *const *phandles, uint8_t count);
+
+#ifdef OLED_USING_DMA_TRANSMIT
+OLED_StatusTypeDef OLEDH_Refresh_Async(OLED_HandleTypeDef *phandle);
+void OLEDH_Transmit_Done(OLED_HandleTypeDef *phandle, OLED_StatusTypeDef status);
+OLED_RefreshStateTypeDef OLEDH_Get_Refresh_State(OLED_HandleTypeDef *phandle);
+OLED_StatusTypeDef OLEDH_Wait_Refresh(OLED_HandleTypeDef *phandle);
+#endif
+
+OLED_StatusTypeDef OLEDH_setPoint(OLED_HandleTypeDef *phandle, uint8_t x, uint8_t y, uint8_t state);
+OLED_StatusTypeDef OLEDH_Fill(OLED_HandleTypeDef *phandle, uint8_t state);
+OLED_StatusTypeDef OLEDH_Clear(OLED_HandleTypeDef *phandle);
+void OLEDH_Fill_Buffer(OLED_HandleTypeDef *phandle, uint8_t state);
+void OLEDH_Clear_Buffer(OLED_HandleTypeDef *phandle);
+OLED_StatusTypeDef OLEDH_ShowStr(OLED_HandleTypeDef *phandle, uint8_t x, uint8_t y, uint8_t *pstr, uint8_t text_size);
+uint8_t OLEDH_Draw_Char(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t chr, uint8_t text_size,
+                        OLED_RopTypeDef rop);
+uint16_t OLEDH_Draw_String(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const uint8_t *pstr, uint8_t text_size,
+                           OLED_RopTypeDef rop);
+uint8_t OLEDH_Draw_Chinese(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t index, OLED_RopTypeDef rop);
+OLED_StatusTypeDef OLEDH_ON(OLED_HandleTypeDef *phandle);
+OLED_StatusTypeDef OLEDH_OFF(OLED_HandleTypeDef *phandle);
+void OLEDH_Set_Register(OLED_HandleTypeDef *phandle, OLED_RegisterTypeDef reg, uint8_t value);
+void OLEDH_Set_Contrast(OLED_HandleTypeDef *phandle, uint8_t contrast);
+void OLEDH_Set_Invert(OLED_HandleTypeDef *phandle, uint8_t invert);
+void OLEDH_Set_Display(OLED_HandleTypeDef *phandle, uint8_t on);
+OLED_StatusTypeDef OLEDH_Flush_Registers(OLED_HandleTypeDef *phandle);
+#ifdef OLED_USING_HARDWARE_SCROLL
+OLED_StatusTypeDef OLEDH_Scroll(OLED_HandleTypeDef *phandle, int8_t rows);
+OLED_StatusTypeDef OLEDH_Scroll_Horizontal_Start(OLED_HandleTypeDef *phandle, uint8_t left, uint8_t page_start,
+                                                 uint8_t page_end, uint8_t interval);
+OLED_StatusTypeDef OLEDH_Scroll_Horizontal_Stop(OLED_HandleTypeDef *phandle);
+#endif
+
 void OLED_Refresh_GSRAM_CallBefore();  // 刷新缓存之前调用的函数
 void OLED_Refresh_GSRAM_CallAfter();   // 刷新缓存之后调用的函数
 
 void OLED_WriteCmd_CallBefore();  // 写命令之前调用的函数
 void OLED_WriteCmd_CallAfter();   // 写命令之后调用的函数
 
+#ifdef OLED_USING_DMA_TRANSMIT
+void OLED_Refresh_Async_CallComplete();  // 异步刷新完成后在中断里调用的函数
+void OLED_Wait_Refresh_Idle();           // 等待异步刷新期间反复调用的函数，可以在这里休眠或让出CPU
+#endif
+
 #ifdef __cplusplus
 }
 #endif  // C++ Support
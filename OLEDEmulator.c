@@ -0,0 +1,446 @@
+/**
+ * @Description OLED控制器主机端仿真，解析OLED_Transmit收到的命令流写入仿真GDDRAM
+ * @Author jinming xi
+ * @Date 2022/11/3
+ * @Project OLEDDriver
+ */
+#include "OLEDEmulator.h"
+
+#ifdef OLED_USING_EMULATOR
+
+OLED_EmuTypeDef g_oled_emu;
+
+/**
+ * 多字节命令的总长度
+ * @note 只能页寻址的芯片也按SSD1306的长度吃掉0x20~0x22的参数
+ * @param pemu 仿真控制器
+ * @param cmd 命令首字节
+ * @return 命令长度
+ */
+static uint8_t OLED_Emu_Cmd_Length(const OLED_EmuTypeDef *pemu, uint8_t cmd)
+{
+  switch (cmd) {
+    case 0x20: case 0x81: case 0x8d: case 0xa8: case 0xad: case 0xd3:
+    case 0xd5: case 0xd9: case 0xda: case 0xdb: return 2;
+    case 0x21: case 0x22: case 0xa3: return 3;
+    case 0x29: case 0x2a: return 6;
+    case 0x26: case 0x27: return OLED_SCROLL_SSD1309 == pemu->pcontroller->continuous_scroll ? 8 : 7;
+    default: return 1;
+  }
+}
+
+/**
+ * 执行一条完整的命令
+ * @param pemu 仿真控制器
+ * @param pcmd 命令字节
+ */
+static void OLED_Emu_Execute(OLED_EmuTypeDef *pemu, const uint8_t *pcmd)
+{
+  uint8_t cmd = pcmd[0];
+  uint8_t horizontal = pemu->pcontroller->horizontal;
+  uint8_t page_mode = !horizontal || 2 == pemu->addressing_mode;
+  if (cmd <= 0x0f) {
+    if (page_mode) pemu->column = (pemu->column & 0xf0) | cmd;
+  } else if (cmd <= 0x1f) {
+    if (page_mode) pemu->column = (pemu->column & 0x0f) | ((cmd & 0x0f) << 4);
+  } else if (cmd >= 0x40 && cmd <= 0x7f) {
+    pemu->start_line = cmd & 0x3f;
+  } else if (cmd >= 0xb0 && cmd <= 0xb7) {
+    if (page_mode) pemu->page = cmd & 0x07;
+  } else {
+    if (!horizontal && cmd >= 0x20 && cmd <= 0x22) return;  // 不支持水平寻址的芯片忽略寻址设置
+    switch (cmd) {
+      case 0x20: pemu->addressing_mode = pcmd[1] & 0x03; break;
+      case 0x21:
+        pemu->column_start = pcmd[1] & 0x7f;
+        pemu->column_end = pcmd[2] & 0x7f;
+        if (!page_mode) pemu->column = pemu->column_start;
+        break;
+      case 0x22:
+        pemu->page_start = pcmd[1] & 0x07;
+        pemu->page_end = pcmd[2] & 0x07;
+        if (!page_mode) pemu->page = pemu->page_start;
+        break;
+      case 0x26: case 0x27:
+        pemu->scroll_left = cmd & 0x01;
+        pemu->scroll_page_start = pcmd[2] & 0x07;
+        pemu->scroll_page_end = pcmd[4] & 0x07;
+        if (OLED_SCROLL_SSD1309 == pemu->pcontroller->continuous_scroll) {
+          pemu->scroll_column_start = pcmd[6] & 0x7f;
+          pemu->scroll_column_end = pcmd[7] & 0x7f;
+        } else {
+          pemu->scroll_column_start = 0;
+          pemu->scroll_column_end = pemu->pcontroller->ram_width - 1;
+        }
+        break;
+      case 0x2e: pemu->scroll_on = 0; break;
+      case 0x2f: pemu->scroll_on = 1; break;
+      case 0x81: pemu->contrast = pcmd[1]; break;
+      case 0xa0: case 0xa1: pemu->seg_remap = cmd & 0x01; break;
+      case 0xa4: case 0xa5: pemu->entire_on = cmd & 0x01; break;
+      case 0xa8: pemu->mux = pcmd[1] & 0x3f; break;
+      case 0xa6: case 0xa7: pemu->invert = cmd & 0x01; break;
+      case 0xae: case 0xaf: pemu->display_on = cmd & 0x01; break;
+      case 0xc0: case 0xc8: pemu->com_remap = (cmd >> 3) & 0x01; break;
+      case 0xd3: pemu->offset = pcmd[1] & 0x3f; break;
+      case 0xda: pemu->com_config = pcmd[1]; break;
+      default: break;
+    }
+  }
+}
+
+/**
+ * 接收一个命令字节
+ * @param pemu 仿真控制器
+ * @param byte 命令字节
+ */
+static void OLED_Emu_Command(OLED_EmuTypeDef *pemu, uint8_t byte)
+{
+  if (0 == pemu->cmd_count) pemu->cmd_total = OLED_Emu_Cmd_Length(pemu, byte);
+  pemu->cmd[pemu->cmd_count++] = byte;
+  if (pemu->cmd_count < pemu->cmd_total) return;
+  OLED_Emu_Execute(pemu, pemu->cmd);
+  pemu->cmd_count = 0;
+}
+
+/**
+ * 写入一个显示数据字节并按寻址模式移动地址指针
+ * @param pemu 仿真控制器
+ * @param byte 显示数据
+ */
+static void OLED_Emu_Data(OLED_EmuTypeDef *pemu, uint8_t byte)
+{
+  const uint8_t columns = pemu->pcontroller->ram_width;
+  if (pemu->column < columns) pemu->gddram[pemu->page][pemu->column] = byte;
+  if (!pemu->pcontroller->horizontal) {
+    if (pemu->column < columns) pemu->column++;  // 只能页寻址的芯片写到最后一列后停住
+    return;
+  }
+  switch (pemu->addressing_mode) {
+    case 0:  // 水平寻址，列到头后换页
+      if (pemu->column++ < pemu->column_end) break;
+      pemu->column = pemu->column_start;
+      pemu->page = pemu->page >= pemu->page_end ? pemu->page_start : pemu->page + 1;
+      break;
+    case 1:  // 垂直寻址，页到头后换列
+      if (pemu->page++ < pemu->page_end) break;
+      pemu->page = pemu->page_start;
+      pemu->column = pemu->column >= pemu->column_end ? pemu->column_start : pemu->column + 1;
+      break;
+    default:  // 页寻址，列到头后回到0，页不变
+      pemu->column = (pemu->column + 1) % columns;
+      break;
+  }
+}
+
+void OLED_Emu_Init(OLED_EmuTypeDef *pemu, const OLED_ControllerTypeDef *pcontroller, uint8_t width, uint8_t height)
+{
+  OLED_EmuBusTypeDef bus = pemu->bus;
+  uint32_t clock = pemu->bus_clock;
+  memset(pemu, 0, sizeof(*pemu));
+  memset(pemu->gddram, 0xa5, sizeof(pemu->gddram));
+  pemu->pcontroller = NULL != pcontroller ? pcontroller : g_oled_handle.pcontroller;
+  pemu->addressing_mode = 2;  // 上电默认页寻址
+  pemu->column_end = pemu->pcontroller->ram_width - 1;
+  pemu->page_end = OLED_EMU_RAM_PAGES - 1;
+  pemu->contrast = 0x7f;
+  pemu->mux = 63;           // 上电默认64路
+  pemu->com_config = 0x12;  // 上电默认交替连接
+  pemu->bus = bus;
+  pemu->bus_clock = clock ? clock : 400000;
+  pemu->width = width;
+  pemu->height = height;
+  pemu->column_offset = pemu->pcontroller->column_offset;
+  pemu->com_pins = OLED_DEFAULT_COM_PINS(width, height);
+}
+
+void OLED_Emu_Reset(void)
+{
+  OLED_Emu_Init(&g_oled_emu, g_oled_handle.pcontroller, OLED_PIX_WIDTH, OLED_PIX_HEIGHT);
+  g_oled_emu.column_offset += OLED_COLUMN_OFFSET;
+  if (OLED_COM_PINS) g_oled_emu.com_pins = OLED_COM_PINS;
+}
+
+void OLED_Emu_Set_Bus(OLED_EmuBusTypeDef bus, uint32_t clock)
+{
+  g_oled_emu.bus = bus;
+  g_oled_emu.bus_clock = clock;
+}
+
+void OLED_Emu_Clear_Stats(void) { memset(&g_oled_emu.stats, 0, sizeof(g_oled_emu.stats)); }
+
+const OLED_EmuTypeDef *OLED_Emu_Get(void) { return &g_oled_emu; }
+
+uint8_t OLED_Emu_Get_Pixel(uint8_t x, uint8_t y) { return OLED_Emu_Read_Pixel(&g_oled_emu, x, y); }
+
+uint8_t OLED_Emu_Read_Pixel(const OLED_EmuTypeDef *pemu, uint8_t x, uint8_t y)
+{
+  if (x >= pemu->width || y >= pemu->height || !pemu->display_on) return 0;
+  if (pemu->entire_on) return 1;
+  // 驱动以0xa1/0xc8作为正常方向，段重映射反过来后屏幕第x列接在GDDRAM另一端数起的那一列上
+  uint8_t column = pemu->seg_remap ? x + pemu->column_offset
+                                   : pemu->pcontroller->ram_width - 1 - pemu->column_offset - x;
+  // COM配置与屏幕的接法不一致时行会隔行错位，例如128x32的屏幕按交替连接只能显示偶数行
+  uint8_t row = y, alternative = pemu->com_config & 0x10;
+  if (alternative && !(pemu->com_pins & 0x10))
+    row = y < 32 ? 2 * y : 2 * (y - 32) + 1;
+  else if (!alternative && (pemu->com_pins & 0x10))
+    row = y / 2 + (y & 1 ? 32 : 0);
+  if (row > pemu->mux) return 0;  // 多路复用比之外的行不扫描
+  if (!pemu->com_remap) row = pemu->mux - row;
+  row = (row + pemu->start_line + pemu->offset) % (OLED_EMU_RAM_PAGES * 8);
+  uint8_t pixel = (pemu->gddram[row / 8][column] >> (row % 8)) & 0x01;
+  return pixel ^ pemu->invert;
+}
+
+/**
+ * 写入PBM头部中的一个十进制数
+ * @param pout 输出位置
+ * @param value 数值
+ * @return 写入的字节数
+ */
+static uint8_t OLED_Emu_PBM_Put_Number(uint8_t *pout, uint8_t value)
+{
+  uint8_t length = value >= 100 ? 3 : (value >= 10 ? 2 : 1);
+  for (uint8_t i = length; i > 0; --i) {
+    pout[i - 1] = '0' + value % 10;
+    value /= 10;
+  }
+  return length;
+}
+
+uint32_t OLED_Emu_Export_PBM(const OLED_EmuTypeDef *pemu, uint8_t *pout, uint32_t size)
+{
+  uint32_t length = 0, stride = (pemu->width + 7U) / 8U;
+  if (size < OLED_EMU_PBM_SIZE(pemu->width, pemu->height)) return 0;
+  pout[length++] = 'P';
+  pout[length++] = '4';
+  pout[length++] = '\n';
+  length += OLED_Emu_PBM_Put_Number(&pout[length], pemu->width);
+  pout[length++] = ' ';
+  length += OLED_Emu_PBM_Put_Number(&pout[length], pemu->height);
+  pout[length++] = '\n';
+  memset(&pout[length], 0, stride * pemu->height);
+  for (uint8_t y = 0; y < pemu->height; ++y)
+    for (uint8_t x = 0; x < pemu->width; ++x)
+      if (OLED_Emu_Read_Pixel(pemu, x, y)) pout[length + y * stride + x / 8] |= 0x80 >> (x % 8);
+  return length + stride * pemu->height;
+}
+
+/**
+ * 跳过PBM中的空白与#注释
+ * @param ppbm 图像
+ * @param size 图像字节数
+ * @param pos 当前位置
+ * @return 下一个有效字符的位置
+ */
+static uint32_t OLED_Emu_PBM_Skip(const uint8_t *ppbm, uint32_t size, uint32_t pos)
+{
+  while (pos < size) {
+    if ('#' == ppbm[pos]) {
+      while (pos < size && '\n' != ppbm[pos]) pos++;
+    } else if (' ' == ppbm[pos] || '\t' == ppbm[pos] || '\r' == ppbm[pos] || '\n' == ppbm[pos]) {
+      pos++;
+    } else {
+      break;
+    }
+  }
+  return pos;
+}
+
+/**
+ * 读取PBM头部中的一个十进制数
+ * @param ppbm 图像
+ * @param size 图像字节数
+ * @param ppos 当前位置，返回数字之后的位置
+ * @return 数值，没有数字或者超过255时返回-1
+ */
+static int16_t OLED_Emu_PBM_Number(const uint8_t *ppbm, uint32_t size, uint32_t *ppos)
+{
+  uint32_t pos = OLED_Emu_PBM_Skip(ppbm, size, *ppos);
+  int16_t value = -1;
+  while (pos < size && ppbm[pos] >= '0' && ppbm[pos] <= '9') {
+    value = (value < 0 ? 0 : value * 10) + (ppbm[pos++] - '0');
+    if (value > 255) return -1;
+  }
+  *ppos = pos;
+  return value;
+}
+
+int32_t OLED_Emu_Compare_PBM(const OLED_EmuTypeDef *pemu, const uint8_t *ppbm, uint32_t size)
+{
+  uint32_t pos = 2, stride = (pemu->width + 7U) / 8U;
+  int32_t diff = 0;
+  if (size < 2 || 'P' != ppbm[0] || ('1' != ppbm[1] && '4' != ppbm[1])) return -1;
+  uint8_t binary = '4' == ppbm[1];
+  if (OLED_Emu_PBM_Number(ppbm, size, &pos) != pemu->width || OLED_Emu_PBM_Number(ppbm, size, &pos) != pemu->height)
+    return -1;
+  if (binary) {
+    // 高度之后只有一个空白字符，之后就是图像数据
+    if (pos + 1 + stride * pemu->height > size) return -1;
+    pos++;
+  }
+  for (uint8_t y = 0; y < pemu->height; ++y) {
+    for (uint8_t x = 0; x < pemu->width; ++x) {
+      uint8_t pixel;
+      if (binary) {
+        pixel = (ppbm[pos + y * stride + x / 8] >> (7 - x % 8)) & 0x01;
+      } else {
+        pos = OLED_Emu_PBM_Skip(ppbm, size, pos);
+        if (pos >= size || ('0' != ppbm[pos] && '1' != ppbm[pos])) return -1;
+        pixel = ppbm[pos++] - '0';
+      }
+      if (pixel != OLED_Emu_Read_Pixel(pemu, x, y)) diff++;
+    }
+  }
+  return diff;
+}
+
+/**
+ * 仿真控制器解析收到的字节并计数
+ * @param pemu 仿真控制器
+ * @param pData 数据指针
+ * @param Size 数据长度
+ * @param mode 传输模式:0->命令;1->数据
+ */
+static void OLED_Emu_Receive(OLED_EmuTypeDef *pemu, const uint8_t *pData, uint16_t Size, uint8_t mode)
+{
+  OLED_EmuStatsTypeDef *pstats = &pemu->stats;
+  if (0 == mode) {
+    pstats->cmd_transfers++;
+    pstats->cmd_bytes += Size;
+    for (uint16_t i = 0; i < Size; ++i) OLED_Emu_Command(pemu, pData[i]);
+  } else {
+    pstats->data_transfers++;
+    pstats->data_bytes += Size;
+    for (uint16_t i = 0; i < Size; ++i) OLED_Emu_Data(pemu, pData[i]);
+  }
+}
+
+uint8_t OLED_Emu_Scroll_Step(OLED_EmuTypeDef *pemu)
+{
+  uint8_t first = pemu->scroll_column_start, last = pemu->scroll_column_end;
+  if (!pemu->scroll_on || first >= last || last >= pemu->pcontroller->ram_width) return 0;
+  for (uint8_t page = pemu->scroll_page_start; page <= pemu->scroll_page_end; ++page) {
+    uint8_t *prow = pemu->gddram[page];
+    if (pemu->scroll_left) {
+      uint8_t carry = prow[first];
+      memmove(&prow[first], &prow[first + 1], last - first);
+      prow[last] = carry;
+    } else {
+      uint8_t carry = prow[last];
+      memmove(&prow[first + 1], &prow[first], last - first);
+      prow[first] = carry;
+    }
+  }
+  return 1;
+}
+
+/**
+ * 有异步刷新正在进行时记下发起传输的屏幕实例，等待OLED_Emu_Done模拟完成中断
+ * @param pemu 仿真控制器
+ * @param phandle 发起传输的屏幕实例
+ */
+static void OLED_Emu_Pending(OLED_EmuTypeDef *pemu, OLED_HandleTypeDef *phandle)
+{
+#  ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == OLEDH_Get_Refresh_State(phandle)) pemu->ppending = phandle;
+#  else
+  (void)pemu;
+  (void)phandle;
+#  endif
+}
+
+/**
+ * 仿真控制器接收一次传输
+ * @param pemu 仿真控制器
+ * @param phandle 发起传输的屏幕实例
+ * @param pData 数据指针
+ * @param Size 数据长度
+ * @param mode 传输模式:0->命令;1->数据
+ * @return OLED Status
+ */
+static OLED_StatusTypeDef OLED_Emu_Transfer(OLED_EmuTypeDef *pemu, OLED_HandleTypeDef *phandle, uint8_t *pData,
+                                            uint16_t Size, uint8_t mode)
+{
+  uint64_t clocks;
+  if (OLED_EMU_BUS_I2C == pemu->bus)
+    clocks = (uint64_t)(Size + 2) * 9 + 2;  // 起始+设备地址+控制字节+数据+停止
+  else
+    clocks = (uint64_t)Size * 8;
+  pemu->stats.wire_ns += clocks * 1000000000ULL / pemu->bus_clock;
+  OLED_Emu_Receive(pemu, pData, Size, mode);
+  OLED_Emu_Pending(pemu, phandle);
+  return OLED_OK;
+}
+
+/**
+ * 仿真的传输函数，替代用户实现的OLED_Transmit
+ * @param DevAddress 设备地址
+ * @param MemAddress 内存地址
+ * @param pData 数据指针
+ * @param Size 数据长度
+ * @param mode 传输模式:0->命令;1->数据
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Transmit(uint16_t DevAddress, uint16_t MemAddress, uint8_t *pData, uint16_t Size, uint8_t mode)
+{
+  (void)DevAddress;
+  (void)MemAddress;
+  return OLED_Emu_Transfer(&g_oled_emu, &g_oled_handle, pData, Size, mode);
+}
+
+static OLED_StatusTypeDef OLED_Emu_Transport_Transmit(OLED_HandleTypeDef *phandle, uint8_t *pData, uint16_t Size,
+                                                      uint8_t mode)
+{
+  return OLED_Emu_Transfer((OLED_EmuTypeDef *)phandle->puser, phandle, pData, Size, mode);
+}
+
+#  ifdef OLED_USING_SCATTER_GATHER
+/**
+ * 仿真的分段传输函数
+ * @note I2C下整个列表是一次传输，段之间用重复起始加设备地址切换控制字节，最后一段之后才有停止
+ * @param phandle 屏幕实例
+ * @param psegments 分段列表
+ * @param count 段数
+ * @return OLED Status
+ */
+static OLED_StatusTypeDef OLED_Emu_Transport_Transmit_List(OLED_HandleTypeDef *phandle,
+                                                           const OLED_SegmentTypeDef *psegments, uint16_t count)
+{
+  OLED_EmuTypeDef *pemu = (OLED_EmuTypeDef *)phandle->puser;
+  uint64_t clocks = OLED_EMU_BUS_I2C == pemu->bus ? 1 : 0;  // 停止
+  for (uint16_t i = 0; i < count; ++i) {
+    if (OLED_EMU_BUS_I2C == pemu->bus)
+      clocks += (uint64_t)(psegments[i].size + 2) * 9 + 1;  // (重复)起始+设备地址+控制字节+数据
+    else
+      clocks += (uint64_t)psegments[i].size * 8;
+    OLED_Emu_Receive(pemu, psegments[i].pdata, psegments[i].size, psegments[i].mode);
+  }
+  pemu->stats.wire_ns += clocks * 1000000000ULL / pemu->bus_clock;
+  pemu->stats.list_transfers++;
+  OLED_Emu_Pending(pemu, phandle);
+  return OLED_OK;
+}
+#  endif
+
+const OLED_TransportTypeDef g_oled_emu_transport = {
+    .transmit = OLED_Emu_Transport_Transmit,
+#  ifdef OLED_USING_SCATTER_GATHER
+    .transmit_list = OLED_Emu_Transport_Transmit_List,
+#  endif
+};
+
+#  ifdef OLED_USING_DMA_TRANSMIT
+uint8_t OLED_Emu_Done(OLED_EmuTypeDef *pemu)
+{
+  OLED_HandleTypeDef *phandle = pemu->ppending;
+  if (NULL == phandle) return 0;
+  pemu->ppending = NULL;
+  OLEDH_Transmit_Done(phandle, OLED_OK);
+  return 1;
+}
+
+uint8_t OLED_Emu_Complete(void) { return OLED_Emu_Done(&g_oled_emu); }
+#  endif
+#endif
@@ -0,0 +1,199 @@
+/**
+ * @Description OLED控制器主机端仿真，用于脱离硬件测量驱动的总线开销
+ * @Author jinming xi
+ * @Date 2022/11/3
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDEMULATOR_H
+#define OLEDEMULATOR_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+#ifdef OLED_USING_EMULATOR
+
+#  define OLED_EMU_RAM_WIDTH 132  // GDDRAM列数，按SH1106的132列分配，128列的芯片只用到前128列
+#  define OLED_EMU_RAM_PAGES 8    // GDDRAM页数
+
+/**
+ * @brief 仿真总线类型
+ */
+typedef enum {
+  OLED_EMU_BUS_I2C = 0x00U,  // 每字节9个时钟(含ACK)，每次传输额外有起始、设备地址、控制字节与停止
+  OLED_EMU_BUS_SPI = 0x01U,  // 每字节8个时钟
+} OLED_EmuBusTypeDef;
+
+/**
+ * @brief 总线统计，命令与数据分开计数
+ */
+typedef struct {
+  uint32_t cmd_transfers;   // 命令传输次数
+  uint32_t cmd_bytes;       // 命令字节数
+  uint32_t data_transfers;  // 数据传输次数
+  uint32_t data_bytes;      // 数据字节数
+  uint32_t list_transfers;  // 分段列表的提交次数，列表中的每一段仍计入上面的传输次数
+  uint64_t wire_ns;         // 按总线时钟估算的传输时间(ns)
+} OLED_EmuStatsTypeDef;
+
+/**
+ * @brief 仿真的控制器状态
+ */
+typedef struct {
+  const OLED_ControllerTypeDef *pcontroller;  // 仿真的芯片，决定列数、列偏移以及是否支持水平寻址
+  uint8_t gddram[OLED_EMU_RAM_PAGES][OLED_EMU_RAM_WIDTH];
+  uint8_t addressing_mode;  // 0:水平 1:垂直 2:页寻址
+  uint8_t column;           // 当前列
+  uint8_t page;             // 当前页
+  uint8_t column_start;     // 0x21设置的列范围
+  uint8_t column_end;
+  uint8_t page_start;  // 0x22设置的页范围
+  uint8_t page_end;
+  uint8_t start_line;    // 显示起始行 0x40~0x7f
+  uint8_t offset;        // 显示偏移 0xd3
+  uint8_t mux;           // 多路复用比 0xa8，扫描mux + 1行
+  uint8_t com_config;    // COM引脚配置 0xda
+  uint8_t contrast;      // 对比度 0x81
+  uint8_t seg_remap;     // 0xa0/0xa1
+  uint8_t com_remap;     // 0xc0/0xc8
+  uint8_t invert;        // 0xa6/0xa7
+  uint8_t entire_on;     // 0xa4/0xa5
+  uint8_t display_on;    // 0xae/0xaf
+  uint8_t scroll_on;     // 0x2e/0x2f
+  uint8_t scroll_left;   // 0x26向右、0x27向左，方向按GDDRAM列
+  // 0x26/0x27设置的滚动区域，SSD1306格式的列范围为整个GDDRAM
+  uint8_t scroll_page_start;
+  uint8_t scroll_page_end;
+  uint8_t scroll_column_start;
+  uint8_t scroll_column_end;
+  OLED_EmuBusTypeDef bus;
+  uint32_t bus_clock;  // 总线时钟(Hz)
+  OLED_EmuStatsTypeDef stats;
+  uint8_t width;          // 屏幕横向像素
+  uint8_t height;         // 屏幕纵向像素
+  uint8_t column_offset;  // 屏幕第0列接在哪一列GDDRAM上(0xa1时)，OLED_Emu_Init设为芯片的列偏移
+  uint8_t com_pins;       // 屏幕行与COM的接法，0x02顺序、0x12交替，OLED_Emu_Init按OLED_DEFAULT_COM_PINS设置
+  uint8_t cmd[8];         // 正在接收的多字节命令
+  uint8_t cmd_count;      // 已接收的字节数
+  uint8_t cmd_total;      // 命令总长度
+#  ifdef OLED_USING_DMA_TRANSMIT
+  OLED_HandleTypeDef *ppending;  // 有一次传输等待完成的屏幕实例
+#  endif
+} OLED_EmuTypeDef;
+
+/**
+ * @brief 默认的仿真控制器，OLED_Transmit写入这里
+ */
+extern OLED_EmuTypeDef g_oled_emu;
+
+/**
+ * @brief 仿真的传输函数表，phandle->puser指向各自的OLED_EmuTypeDef，用于多实例仿真
+ * @note 定义OLED_USING_SCATTER_GATHER时同时提供transmit_list
+ */
+extern const OLED_TransportTypeDef g_oled_emu_transport;
+
+/**
+ * 复位仿真控制器，GDDRAM填充为0xa5模拟上电后的随机内容，总线统计清零，总线设置保持不变
+ * @note 仿真列偏移不同或者接法特殊的屏幕时，调用之后修改column_offset与com_pins
+ * @param pemu 仿真控制器
+ * @param pcontroller 仿真的芯片，为NULL时与默认实例相同
+ * @param width 屏幕横向像素
+ * @param height 屏幕纵向像素
+ */
+void OLED_Emu_Init(OLED_EmuTypeDef *pemu, const OLED_ControllerTypeDef *pcontroller, uint8_t width, uint8_t height);
+
+/**
+ * 复位默认的仿真控制器，芯片与默认实例的pcontroller相同
+ */
+void OLED_Emu_Reset(void);
+
+/**
+ * 设置仿真总线
+ * @param bus 总线类型
+ * @param clock 总线时钟(Hz)，例如I2C的100000/400000/1000000
+ */
+void OLED_Emu_Set_Bus(OLED_EmuBusTypeDef bus, uint32_t clock);
+
+/**
+ * 清零总线统计
+ */
+void OLED_Emu_Clear_Stats(void);
+
+/**
+ * 获取仿真控制器状态
+ * @return 仿真控制器
+ */
+const OLED_EmuTypeDef *OLED_Emu_Get(void);
+
+/**
+ * 读取屏幕上实际显示的一个点，考虑了列偏移、多路复用比、COM引脚配置、起始行、显示偏移、翻转、反色等设置
+ * @note 坐标为屏幕的原始方向，与OLED_ROTATION无关
+ * @param x 横坐标 0~横向像素 - 1
+ * @param y 纵坐标 0~纵向像素 - 1
+ * @return 点亮为1，熄灭为0
+ */
+uint8_t OLED_Emu_Get_Pixel(uint8_t x, uint8_t y);
+
+/**
+ * 读取某个仿真控制器屏幕上实际显示的一个点
+ * @param pemu 仿真控制器
+ * @param x 横坐标 0~横向像素 - 1
+ * @param y 纵坐标 0~纵向像素 - 1
+ * @return 点亮为1，熄灭为0
+ */
+uint8_t OLED_Emu_Read_Pixel(const OLED_EmuTypeDef *pemu, uint8_t x, uint8_t y);
+
+/**
+ * @brief 导出一幅PBM(P4)图像最多需要的字节数，头部"P4\n255 255\n"最长11字节
+ */
+#  define OLED_EMU_PBM_SIZE(width, height) (11U + ((uint32_t)(width) + 7U) / 8U * (height))
+
+/**
+ * 把屏幕上实际显示的画面导出为二进制PBM(P4)图像，点亮的点为1(黑色)，每行按字节补齐
+ * @note 只写入内存，由调用者保存为文件，用于检查画面或者生成基准图像
+ * @param pemu 仿真控制器
+ * @param pout 输出缓存
+ * @param size 输出缓存大小，至少为OLED_EMU_PBM_SIZE(width, height)
+ * @return 写入的字节数，缓存不够时返回0
+ */
+uint32_t OLED_Emu_Export_PBM(const OLED_EmuTypeDef *pemu, uint8_t *pout, uint32_t size);
+
+/**
+ * 把屏幕上实际显示的画面与基准的PBM图像逐点比较
+ * @note 支持P1(文本)与P4(二进制)，可以含#注释，与OLED_Emu_Export_PBM相同，1为点亮
+ * @param pemu 仿真控制器
+ * @param ppbm 基准图像
+ * @param size 图像字节数
+ * @return 不同的点数，图像格式错误或者尺寸与屏幕不同时返回-1
+ */
+int32_t OLED_Emu_Compare_PBM(const OLED_EmuTypeDef *pemu, const uint8_t *ppbm, uint32_t size);
+
+/**
+ * 连续水平滚动前进一列: 0x2f开启滚动后，把滚动区域内的GDDRAM按方向循环移动一列，与控制器滚动时改写GDDRAM相同
+ * @param pemu 仿真控制器
+ * @return 没有开启滚动时返回0
+ */
+uint8_t OLED_Emu_Scroll_Step(OLED_EmuTypeDef *pemu);
+
+#  ifdef OLED_USING_DMA_TRANSMIT
+/**
+ * 模拟DMA传输完成中断，异步刷新时每调用一次推进一步
+ * @return 没有正在进行的传输时返回0
+ */
+uint8_t OLED_Emu_Complete(void);
+
+/**
+ * 模拟某个仿真控制器的DMA传输完成中断
+ * @param pemu 仿真控制器
+ * @return 没有正在进行的传输时返回0
+ */
+uint8_t OLED_Emu_Done(OLED_EmuTypeDef *pemu);
+#  endif
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDEMULATOR_H
@@ -0,0 +1,154 @@
+/**
+ * @Description 字库与UTF-8文字渲染
+ * @Author jinming xi
+ * @Date 2022/11/3
+ * @Project OLEDDriver
+ */
+#include "OLEDFont.h"
+#include "OLEDGraphics.h"
+#include "codetable.h"
+
+/**
+ * @brief codetable中16x16汉字的索引，码点升序，offset为原表中的序号 * 32
+ */
+static const OLED_GlyphTypeDef g_oled_cn16_glyphs[F16X16_COUNT] = {
+    {0x58a8, 1 * 32, 16, 16},  // 墨
+    {0x6db5, 0 * 32, 16, 16},  // 涵
+    {0x7b19, 3 * 32, 16, 16},  // 笙
+    {0x8f7b, 2 * 32, 16, 16},  // 轻
+};
+
+const OLED_FontTypeDef g_oled_font_6x8 = {F6x8[0], NULL, F6X8_COUNT, FONT_FIRST_CHAR, 6, 8, NULL};
+const OLED_FontTypeDef g_oled_font_8x16 = {F8X16, NULL, F8X16_COUNT, FONT_FIRST_CHAR, 8, 16, NULL};
+const OLED_FontTypeDef g_oled_font_cn16 = {F16x16, g_oled_cn16_glyphs, F16X16_COUNT, 0, 0, 16, &g_oled_font_8x16};
+
+uint32_t OLED_UTF8_Next(const char **ppstr)
+{
+  const uint8_t *pstr = (const uint8_t *)*ppstr;
+  uint32_t code = pstr[0];
+  uint8_t length;
+  uint32_t min;
+  if (code < 0x80) {
+    if (0 != code) *ppstr += 1;
+    return code;
+  } else if (0xc0 == (code & 0xe0)) {
+    length = 2, min = 0x80, code &= 0x1f;
+  } else if (0xe0 == (code & 0xf0)) {
+    length = 3, min = 0x800, code &= 0x0f;
+  } else if (0xf0 == (code & 0xf8)) {
+    length = 4, min = 0x10000, code &= 0x07;
+  } else {
+    *ppstr += 1;
+    return OLED_REPLACEMENT_CHAR;
+  }
+  for (uint8_t i = 1; i < length; ++i) {
+    // 截断的序列在'\0'处停下，不会越过字符串结尾
+    if (0x80 != (pstr[i] & 0xc0)) {
+      *ppstr += 1;
+      return OLED_REPLACEMENT_CHAR;
+    }
+    code = (code << 6) | (pstr[i] & 0x3f);
+  }
+  *ppstr += 1;
+  // 超长编码、代理区和超出Unicode范围的码点都视为非法
+  if (code < min || code > 0x10ffff || (code >= 0xd800 && code <= 0xdfff)) return OLED_REPLACEMENT_CHAR;
+  *ppstr += length - 1;
+  return code;
+}
+
+OLED_StatusTypeDef OLED_Font_Get_Glyph(const OLED_FontTypeDef *pfont, uint32_t code, OLED_GlyphInfoTypeDef *pinfo)
+{
+  for (; NULL != pfont; pfont = pfont->pfallback) {
+    uint16_t page_bytes = (pfont->height + 7) / 8;
+    if (NULL == pfont->pglyphs) {
+      if (code < pfont->first || code - pfont->first >= pfont->count) continue;
+      pinfo->pbitmap = pfont->pbitmap + (code - pfont->first) * pfont->width * page_bytes;
+      pinfo->width = pinfo->advance = pfont->width;
+      pinfo->height = pfont->height;
+      return OLED_OK;
+    }
+    uint16_t low = 0, high = pfont->count;
+    while (low < high) {
+      uint16_t mid = low + (high - low) / 2;
+      const OLED_GlyphTypeDef *pglyph = &pfont->pglyphs[mid];
+      if (pglyph->code < code) {
+        low = mid + 1;
+      } else if (pglyph->code > code) {
+        high = mid;
+      } else {
+        pinfo->pbitmap = pfont->pbitmap + pglyph->offset;
+        pinfo->width = pglyph->width;
+        pinfo->advance = pglyph->advance;
+        pinfo->height = pfont->height;
+        return OLED_OK;
+      }
+    }
+  }
+  return OLED_ERROR;
+}
+
+uint8_t OLEDH_Draw_Glyph(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                         uint32_t code, OLED_RopTypeDef rop)
+{
+  OLED_GlyphInfoTypeDef info;
+  if (OLED_OK == OLED_Font_Get_Glyph(pfont, code, &info)) {
+    OLEDH_Draw_Bitmap(phandle, x, y, info.width, info.height, info.pbitmap, rop);
+    return info.advance;
+  }
+  uint8_t width = pfont->height / 2;
+  if (width >= 4) OLEDH_Draw_Rect(phandle, x + 1, y + 1, width - 2, pfont->height - 2, OLED_ROP_AND_NOT != rop);
+  return width;
+}
+
+uint8_t OLED_Draw_Glyph(int16_t x, int16_t y, const OLED_FontTypeDef *pfont, uint32_t code, OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_Glyph(&g_oled_handle, x, y, pfont, code, rop);
+}
+
+/**
+ * 逐行处理UTF-8字符串
+ * @param phandle 屏幕实例，为NULL时只测量宽度
+ * @param x 横坐标
+ * @param y 纵坐标
+ * @param pfont 字库
+ * @param pstr UTF-8字符串
+ * @param rop 光栅操作
+ * @return 最宽一行的宽度
+ */
+static uint16_t OLED_Text_Layout(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                                 const char *pstr, OLED_RopTypeDef rop)
+{
+  uint16_t width = 0, max_width = 0;
+  uint32_t code;
+  while (0 != (code = OLED_UTF8_Next(&pstr))) {
+    if ('\n' == code) {
+      if (width > max_width) max_width = width;
+      width = 0;
+      y += pfont->height;
+      continue;
+    }
+    if (NULL != phandle && x + width < OLEDH_WIDTH(phandle) && y < OLEDH_HEIGHT(phandle)) {
+      width += OLEDH_Draw_Glyph(phandle, x + width, y, pfont, code, rop);
+    } else {
+      OLED_GlyphInfoTypeDef info;
+      width += OLED_OK == OLED_Font_Get_Glyph(pfont, code, &info) ? info.advance : pfont->height / 2;
+    }
+  }
+  return width > max_width ? width : max_width;
+}
+
+uint16_t OLEDH_Draw_Text(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                         const char *pstr, OLED_RopTypeDef rop)
+{
+  return OLED_Text_Layout(phandle, x, y, pfont, pstr, rop);
+}
+
+uint16_t OLED_Draw_Text(int16_t x, int16_t y, const OLED_FontTypeDef *pfont, const char *pstr, OLED_RopTypeDef rop)
+{
+  return OLED_Text_Layout(&g_oled_handle, x, y, pfont, pstr, rop);
+}
+
+uint16_t OLED_Text_Width(const OLED_FontTypeDef *pfont, const char *pstr)
+{
+  return OLED_Text_Layout(NULL, 0, 0, pfont, pstr, OLED_ROP_COPY);
+}
@@ -0,0 +1,115 @@
+/**
+ * @Description 字库与UTF-8文字渲染，字形按码点有序存放，查找为二分查找
+ * @Author jinming xi
+ * @Date 2022/11/3
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDFONT_H
+#define OLEDFONT_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+#define OLED_REPLACEMENT_CHAR 0xfffdU  // 非法UTF-8序列解码的结果
+
+/**
+ * @brief 字形索引项
+ * @note 点阵格式与OLED_Draw_Bitmap相同: 一页width个字节，共(height + 7) / 8页
+ */
+typedef struct {
+  uint32_t code;     // Unicode码点，整个索引按升序排列
+  uint32_t offset;   // 点阵在字库点阵数据中的偏移
+  uint8_t width;     // 点阵宽度
+  uint8_t advance;   // 绘制后光标前进的距离
+} OLED_GlyphTypeDef;
+
+/**
+ * @brief 字库
+ * @note pglyphs为NULL时为从first开始连续编码的等宽字库，第n个字形位于n * width * 页数处，不需要索引
+ */
+typedef struct OLED_FontTypeDef {
+  const uint8_t *pbitmap;                    // 点阵数据
+  const OLED_GlyphTypeDef *pglyphs;          // 字形索引，按码点升序
+  uint16_t count;                            // 字形数
+  uint32_t first;                            // 等宽字库的第一个码点
+  uint8_t width;                             // 等宽字库的字宽
+  uint8_t height;                            // 字高(像素)，同一字库所有字形等高
+  const struct OLED_FontTypeDef *pfallback;  // 缺字时继续查找的字库，可为NULL
+} OLED_FontTypeDef;
+
+/**
+ * @brief 查找到的字形
+ */
+typedef struct {
+  const uint8_t *pbitmap;  // 点阵数据
+  uint8_t width;           // 点阵宽度
+  uint8_t height;          // 点阵高度
+  uint8_t advance;         // 光标前进的距离
+} OLED_GlyphInfoTypeDef;
+
+extern const OLED_FontTypeDef g_oled_font_6x8;   // codetable中的6x8 ASCII
+extern const OLED_FontTypeDef g_oled_font_8x16;  // codetable中的8x16 ASCII
+extern const OLED_FontTypeDef g_oled_font_cn16;  // codetable中的16x16汉字，缺字时使用8x16 ASCII
+
+/**
+ * 从UTF-8字符串中解码一个码点并移动指针
+ * @note 非法或截断的序列返回OLED_REPLACEMENT_CHAR并跳过一个字节
+ * @param ppstr 字符串指针的地址
+ * @return 码点，字符串结束时返回0且不移动指针
+ */
+uint32_t OLED_UTF8_Next(const char **ppstr);
+
+/**
+ * 查找字形，本字库没有时沿pfallback继续查找
+ * @param pfont 字库
+ * @param code 码点
+ * @param pinfo 查找结果
+ * @return 找到返回OLED_OK，所有字库都没有返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Font_Get_Glyph(const OLED_FontTypeDef *pfont, uint32_t code, OLED_GlyphInfoTypeDef *pinfo);
+
+/**
+ * 在任意像素位置绘制一个字形
+ * @note 缺字时绘制一个空心方框
+ * @param x 横坐标，可以为负
+ * @param y 纵坐标(像素)，可以为负
+ * @param pfont 字库
+ * @param code 码点
+ * @param rop 光栅操作
+ * @return 光标前进的距离
+ */
+uint8_t OLED_Draw_Glyph(int16_t x, int16_t y, const OLED_FontTypeDef *pfont, uint32_t code, OLED_RopTypeDef rop);
+
+/**
+ * 绘制UTF-8字符串，遇到'\n'换到下一行，每行超出屏幕右边缘的部分不再绘制
+ * @param x 横坐标，可以为负
+ * @param y 纵坐标(像素)，可以为负
+ * @param pfont 字库
+ * @param pstr UTF-8字符串
+ * @param rop 光栅操作
+ * @return 最宽一行的宽度
+ */
+uint16_t OLED_Draw_Text(int16_t x, int16_t y, const OLED_FontTypeDef *pfont, const char *pstr, OLED_RopTypeDef rop);
+
+/**
+ * @brief 多实例接口，第一个参数为屏幕实例，其余参数与返回值同上面不带句柄的同名函数
+ */
+uint8_t OLEDH_Draw_Glyph(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                         uint32_t code, OLED_RopTypeDef rop);
+uint16_t OLEDH_Draw_Text(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                         const char *pstr, OLED_RopTypeDef rop);
+
+/**
+ * 计算UTF-8字符串绘制后的宽度，不修改显存
+ * @param pfont 字库
+ * @param pstr UTF-8字符串
+ * @return 最宽一行的宽度
+ */
+uint16_t OLED_Text_Width(const OLED_FontTypeDef *pfont, const char *pstr);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDFONT_H
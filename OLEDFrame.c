@@ -0,0 +1,121 @@
+/**
+ * @Description 帧调度，绘制时只提交刷新请求，由定时调用的Tick按固定帧周期合并成一次刷新
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDFrame.h"
+
+/**
+ * 时间a是否已经到达时间b，允许回绕
+ */
+#define OLED_TIME_REACHED(a, b) ((int32_t)((a) - (b)) >= 0)
+
+void OLED_Frame_Init(OLED_FrameSchedulerTypeDef *psched, OLED_HandleTypeDef *phandle, uint32_t period,
+                     uint32_t (*pclock)(void), uint32_t now)
+{
+  memset(psched, 0, sizeof(OLED_FrameSchedulerTypeDef));
+  psched->phandle = phandle;
+  psched->pclock = pclock;
+  psched->period = 0 == period ? 1 : period;
+  psched->next = now;
+  psched->start = now;
+  psched->last = now;
+}
+
+void OLED_Frame_Request(OLED_FrameSchedulerTypeDef *psched)
+{
+  psched->pending = 1;
+  psched->stats.requests++;
+}
+
+/**
+ * 结算已经结束的异步刷新
+ * @param psched 帧调度器
+ * @param now 当前时间
+ */
+static void OLED_Frame_Settle(OLED_FrameSchedulerTypeDef *psched, uint32_t now)
+{
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (!psched->busy || OLED_REFRESH_BUSY == OLEDH_Get_Refresh_State(psched->phandle)) return;
+  psched->busy = 0;
+  psched->stats.busy_time += now - psched->busy_start;
+  if (OLED_REFRESH_ERROR == OLEDH_Get_Refresh_State(psched->phandle)) psched->stats.errors++;
+#else
+  (void)psched;
+  (void)now;
+#endif
+}
+
+/**
+ * 发出一帧
+ * @param psched 帧调度器
+ * @param now 当前时间
+ * @return OLED Status
+ */
+static OLED_StatusTypeDef OLED_Frame_Send(OLED_FrameSchedulerTypeDef *psched, uint32_t now)
+{
+  OLED_StatusTypeDef status;
+  psched->pending = 0;
+  psched->deferred = 0;
+  psched->stats.frames++;
+#ifdef OLED_USING_DMA_TRANSMIT
+  status = OLEDH_Refresh_Async(psched->phandle);
+  if (OLED_REFRESH_BUSY == OLEDH_Get_Refresh_State(psched->phandle)) {
+    psched->busy = 1;
+    psched->busy_start = now;
+    return status;
+  }
+#else
+  status = OLEDH_Refresh_GSRAM(psched->phandle);
+  if (NULL != psched->pclock) psched->stats.busy_time += psched->pclock() - now;
+#endif
+  if (OLED_OK != status) psched->stats.errors++;
+  return status;
+}
+
+OLED_StatusTypeDef OLED_Frame_Tick(OLED_FrameSchedulerTypeDef *psched, uint32_t now)
+{
+  psched->last = now;
+  OLED_Frame_Settle(psched, now);
+  if (!OLED_TIME_REACHED(now, psched->next)) return OLED_OK;
+  // 进入新的帧周期；Tick调用太晚时跳过错过的周期，请求可能刚刚提交，不算丢帧
+  uint32_t missed = (now - psched->next) / psched->period;
+  psched->next += (missed + 1) * psched->period;
+  if (!psched->pending) return OLED_OK;
+  if (psched->busy) {
+    // 上一帧还没有发完，这一帧推迟到下一个周期；之后的请求合并进来，一帧只计一次
+    if (!psched->deferred) psched->stats.dropped++;
+    psched->deferred = 1;
+    return OLED_BUSY;
+  }
+  return OLED_Frame_Send(psched, now);
+}
+
+void OLED_Frame_Get_Stats(const OLED_FrameSchedulerTypeDef *psched, OLED_FrameStatsTypeDef *pstats)
+{
+  *pstats = psched->stats;
+  pstats->elapsed = psched->last - psched->start;
+}
+
+void OLED_Frame_Reset_Stats(OLED_FrameSchedulerTypeDef *psched)
+{
+  memset(&psched->stats, 0, sizeof(OLED_FrameStatsTypeDef));
+  psched->start = psched->last;
+  psched->busy_start = psched->last;  // 正在进行的刷新只统计重置之后的部分
+}
+
+uint32_t OLED_Frame_Get_Fps(const OLED_FrameSchedulerTypeDef *psched, uint32_t tick_rate)
+{
+  uint32_t elapsed = psched->last - psched->start;
+  if (0 == elapsed) return 0;
+  return (uint32_t)((uint64_t)psched->stats.frames * tick_rate * 100 / elapsed);
+}
+
+uint16_t OLED_Frame_Get_Utilization(const OLED_FrameSchedulerTypeDef *psched)
+{
+  uint32_t elapsed = psched->last - psched->start;
+  if (0 == elapsed) return 0;
+  uint64_t permille = (uint64_t)psched->stats.busy_time * 1000 / elapsed;
+  return permille > 1000 ? 1000 : (uint16_t)permille;
+}
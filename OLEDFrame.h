@@ -0,0 +1,104 @@
+/**
+ * @Description 帧调度，绘制时只提交刷新请求，由定时调用的Tick按固定帧周期合并成一次刷新
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDFRAME_H
+#define OLEDFRAME_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+/**
+ * @brief 帧调度统计，时间的单位与OLED_Frame_Tick的now相同
+ */
+typedef struct {
+  uint32_t requests;   // 刷新请求次数，一个帧周期内的多次请求合并为一帧
+  uint32_t frames;     // 实际发出的帧数
+  uint32_t dropped;    // 因为上一帧还在发送而推迟到之后周期的帧数，每一帧只计一次
+  uint32_t errors;     // 刷新失败的帧数
+  uint32_t busy_time;  // 总线忙于刷新的累计时间
+  uint32_t elapsed;    // 开始统计以来经过的时间
+} OLED_FrameStatsTypeDef;
+
+/**
+ * @brief 一块屏幕的帧调度器
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;   // 调度的屏幕实例
+  uint32_t (*pclock)(void);      // 读取当前时间，用于统计阻塞刷新的耗时，可为NULL
+  uint32_t period;               // 帧周期
+  uint32_t next;                 // 下一个帧周期开始的时间
+  uint32_t start;                // 开始统计的时间
+  uint32_t last;                 // 最近一次Tick的时间
+  uint32_t busy_start;           // 正在进行的异步刷新开始的时间
+  volatile uint8_t pending;      // 有尚未发出的刷新请求
+  uint8_t busy;                  // 有异步刷新正在进行
+  uint8_t deferred;              // 等待发送的请求已经推迟过，已计入dropped
+  OLED_FrameStatsTypeDef stats;  // 统计
+} OLED_FrameSchedulerTypeDef;
+
+/**
+ * 初始化帧调度器
+ * @param psched 帧调度器
+ * @param phandle 调度的屏幕实例
+ * @param period 帧周期，单位与OLED_Frame_Tick的now相同，例如now为毫秒时40为25fps
+ * @param pclock 读取当前时间的函数，单位与now相同；为NULL时阻塞刷新的耗时不计入busy_time
+ * @param now 当前时间
+ */
+void OLED_Frame_Init(OLED_FrameSchedulerTypeDef *psched, OLED_HandleTypeDef *phandle, uint32_t period,
+                     uint32_t (*pclock)(void), uint32_t now);
+
+/**
+ * 提交刷新请求，绘制完成后调用，不发送任何数据
+ * @note 请求计数不是原子操作，应与OLED_Frame_Tick在同一个任务中调用，不要在中断或其它任务里调用
+ * @param psched 帧调度器
+ */
+void OLED_Frame_Request(OLED_FrameSchedulerTypeDef *psched);
+
+/**
+ * 帧调度，由定时器或主循环周期性调用，每个帧周期最多发出一次刷新
+ * @note 定义OLED_USING_PARTIAL_REFRESH时只发送改动过的区域
+ * @note 定义OLED_USING_DMA_TRANSMIT时发出异步刷新后立即返回，可以在定时器中断里调用；异步刷新的耗时在之后的Tick里结算，精度为Tick的调用间隔
+ * @note 未定义OLED_USING_DMA_TRANSMIT时在Tick里阻塞刷新，应在主循环中调用
+ * @param psched 帧调度器
+ * @param now 当前时间，单调递增，允许回绕
+ * @return 这一次发出了刷新时返回刷新的结果，上一帧还在发送时返回OLED_BUSY，其余返回OLED_OK
+ */
+OLED_StatusTypeDef OLED_Frame_Tick(OLED_FrameSchedulerTypeDef *psched, uint32_t now);
+
+/**
+ * 读取统计
+ * @param psched 帧调度器
+ * @param pstats 统计输出
+ */
+void OLED_Frame_Get_Stats(const OLED_FrameSchedulerTypeDef *psched, OLED_FrameStatsTypeDef *pstats);
+
+/**
+ * 清零统计，从最近一次Tick的时间开始重新统计
+ * @param psched 帧调度器
+ */
+void OLED_Frame_Reset_Stats(OLED_FrameSchedulerTypeDef *psched);
+
+/**
+ * 开始统计以来的实际帧率
+ * @param psched 帧调度器
+ * @param tick_rate 每秒的时间单位数，例如now为毫秒时为1000
+ * @return 帧率 * 100
+ */
+uint32_t OLED_Frame_Get_Fps(const OLED_FrameSchedulerTypeDef *psched, uint32_t tick_rate);
+
+/**
+ * 开始统计以来的总线占用率
+ * @param psched 帧调度器
+ * @return 千分比
+ */
+uint16_t OLED_Frame_Get_Utilization(const OLED_FrameSchedulerTypeDef *psched);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDFRAME_H
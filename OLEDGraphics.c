@@ -0,0 +1,388 @@
+/**
+ * @Description OLED基本图形绘制，直接按页存储的格式操作实例的显存
+ * @Author jinming xi
+ * @Date 2022/11/3
+ * @Project OLEDDriver
+ */
+#include "OLEDGraphics.h"
+
+/**
+ * 不做范围检查地设置一个点，调用前必须已经裁剪过
+ */
+#define OLED_PLOT(phandle, x, y, state)                                                \
+  do {                                                                                 \
+    uint8_t *pbyte = &(phandle)->pbuffer[((y) >> 3) * (phandle)->width + (x)];         \
+    if (state)                                                                         \
+      *pbyte |= (uint8_t)(1 << ((y) & 7));                                             \
+    else                                                                               \
+      *pbyte &= (uint8_t)~(1 << ((y) & 7));                                            \
+  } while (0)
+
+/**
+ * 对某一页的一段连续列写入同一个位掩码
+ * @param phandle 屏幕实例
+ * @param page 页号
+ * @param x_start 起始列
+ * @param x_end 结束列(包含)
+ * @param mask 位掩码
+ * @param state 点的状态
+ */
+static void OLED_Fill_Span(OLED_HandleTypeDef *phandle, uint8_t page, uint8_t x_start, uint8_t x_end, uint8_t mask,
+                           uint8_t state)
+{
+  uint8_t *prow = &phandle->pbuffer[page * phandle->width + x_start];
+  uint16_t count = x_end - x_start + 1;
+  if (0xff == mask) {
+    memset(prow, state ? 0xff : 0x00, count);
+  } else if (state) {
+    while (count--) *prow++ |= mask;
+  } else {
+    mask = ~mask;
+    while (count--) *prow++ &= mask;
+  }
+}
+
+/**
+ * 填充一个已经裁剪到屏幕内的矩形
+ * @param phandle 屏幕实例
+ * @param x_start 起始列
+ * @param x_end 结束列(包含)
+ * @param y_start 起始行
+ * @param y_end 结束行(包含)
+ * @param state 点的状态
+ */
+static void OLED_Fill_Clipped(OLED_HandleTypeDef *phandle, uint8_t x_start, uint8_t x_end, uint8_t y_start,
+                              uint8_t y_end, uint8_t state)
+{
+  uint8_t page_start = y_start >> 3, page_end = y_end >> 3;
+  uint8_t mask_start = 0xff << (y_start & 7);
+  uint8_t mask_end = 0xff >> (7 - (y_end & 7));
+  if (page_start == page_end) {
+    OLED_Fill_Span(phandle, page_start, x_start, x_end, mask_start & mask_end, state);
+  } else {
+    OLED_Fill_Span(phandle, page_start, x_start, x_end, mask_start, state);
+    for (uint8_t page = page_start + 1; page < page_end; ++page)
+      OLED_Fill_Span(phandle, page, x_start, x_end, 0xff, state);
+    OLED_Fill_Span(phandle, page_end, x_start, x_end, mask_end, state);
+  }
+  OLEDH_MARK_DIRTY(phandle, x_start, x_end, page_start, page_end);
+}
+
+OLED_StatusTypeDef OLEDH_Fill_Rect(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t width, int16_t height,
+                                   uint8_t state)
+{
+  if (width <= 0 || height <= 0) return OLED_OUT_RANGE;
+  OLEDH_PHYS_RECT(phandle, x, y, width, height);
+  int16_t x_end = x + width - 1, y_end = y + height - 1;
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x_end >= phandle->width) x_end = phandle->width - 1;
+  if (y_end >= phandle->height) y_end = phandle->height - 1;
+  if (x > x_end || y > y_end) return OLED_OUT_RANGE;
+  OLED_Fill_Clipped(phandle, x, x_end, y, y_end, state);
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLEDH_Draw_HLine(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t width, uint8_t state)
+{
+  return OLEDH_Fill_Rect(phandle, x, y, width, 1, state);
+}
+
+OLED_StatusTypeDef OLEDH_Draw_VLine(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t height, uint8_t state)
+{
+  return OLEDH_Fill_Rect(phandle, x, y, 1, height, state);
+}
+
+OLED_StatusTypeDef OLEDH_Draw_Rect(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t width, int16_t height,
+                                   uint8_t state)
+{
+  if (width <= 0 || height <= 0) return OLED_OUT_RANGE;
+  uint8_t visible = 0;
+  visible |= OLED_OK == OLEDH_Draw_HLine(phandle, x, y, width, state);
+  visible |= OLED_OK == OLEDH_Draw_HLine(phandle, x, y + height - 1, width, state);
+  visible |= OLED_OK == OLEDH_Draw_VLine(phandle, x, y, height, state);
+  visible |= OLED_OK == OLEDH_Draw_VLine(phandle, x + width - 1, y, height, state);
+  return visible ? OLED_OK : OLED_OUT_RANGE;
+}
+
+/**
+ * 向下取整的整数除法
+ * @param a 被除数，可以为负
+ * @param b 除数，大于0
+ */
+static inline int64_t OLED_Floor_Div(int64_t a, int64_t b) { return a >= 0 ? a / b : -((-a + b - 1) / b); }
+
+/**
+ * 把步数范围[*plo, *phi]收窄到坐标base + step * i在[0, limit - 1]内的部分
+ * @param base 第0步的坐标
+ * @param step 每步的增量，1或-1
+ * @param limit 坐标的上界(不包含)
+ */
+static inline void OLED_Clip_Steps(int32_t base, int8_t step, int32_t limit, int32_t *plo, int32_t *phi)
+{
+  int32_t lo = step > 0 ? -base : base - (limit - 1);
+  int32_t hi = step > 0 ? limit - 1 - base : base;
+  if (lo > *plo) *plo = lo;
+  if (hi < *phi) *phi = hi;
+}
+
+OLED_StatusTypeDef OLEDH_Draw_Line(OLED_HandleTypeDef *phandle, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                   uint8_t state)
+{
+  if (y0 == y1) return OLEDH_Draw_HLine(phandle, x0 < x1 ? x0 : x1, y0, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, state);
+  if (x0 == x1) return OLEDH_Draw_VLine(phandle, x0, y0 < y1 ? y0 : y1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, state);
+
+  // 旋转只是把直线映射成另一条直线，换算两个端点之后都在显存坐标中进行
+  int32_t cx0 = x0, cy0 = y0, cx1 = x1, cy1 = y1;
+  OLEDH_PHYS_POINT(phandle, cx0, cy0);
+  OLEDH_PHYS_POINT(phandle, cx1, cy1);
+
+  // 沿变化较大的主轴每步前进一格，第i步的副轴偏移为round(i * dn / dm)，只由端点决定
+  // 裁剪只收窄步数范围，不改变落下的点，线段分几次在不同区域(例如分条渲染的条带)上绘制时拼起来与一次画完完全一致
+  uint8_t steep = (cy1 > cy0 ? cy1 - cy0 : cy0 - cy1) > (cx1 > cx0 ? cx1 - cx0 : cx0 - cx1);
+  int32_t m0 = steep ? cy0 : cx0, n0 = steep ? cx0 : cy0;
+  int32_t dm = (steep ? cy1 : cx1) - m0, dn = (steep ? cx1 : cy1) - n0;
+  int8_t sm = dm < 0 ? -1 : 1, sn = dn < 0 ? -1 : 1;
+  int32_t m_limit = steep ? phandle->height : phandle->width, n_limit = steep ? phandle->width : phandle->height;
+  dm *= sm;
+  dn *= sn;
+  int32_t lo = 0, hi = dm, k_lo = 0, k_hi = dn;
+  OLED_Clip_Steps(m0, sm, m_limit, &lo, &hi);
+  OLED_Clip_Steps(n0, sn, n_limit, &k_lo, &k_hi);
+  if (k_lo > k_hi) return OLED_OUT_RANGE;
+  // 副轴偏移在[k_lo, k_hi]内的步数范围
+  int64_t i_lo = OLED_Floor_Div(2LL * dm * k_lo - dm + 2 * dn - 1, 2 * dn);
+  int64_t i_hi = OLED_Floor_Div(2LL * dm * (k_hi + 1) - dm - 1, 2 * dn);
+  if (i_lo > lo) lo = (int32_t)i_lo;
+  if (i_hi < hi) hi = (int32_t)i_hi;
+  if (lo > hi) return OLED_OUT_RANGE;
+
+  int64_t num = 2LL * lo * dn + dm;
+  int32_t k = (int32_t)(num / (2 * dm)), rem = (int32_t)(num % (2 * dm));
+  int16_t m_first = m0 + sm * lo, n_first = n0 + sn * k, m = m_first, n = n_first;
+  for (int32_t i = lo; i <= hi; ++i) {
+    if (steep)
+      OLED_PLOT(phandle, n, m, state);
+    else
+      OLED_PLOT(phandle, m, n, state);
+    if (i == hi) break;
+    m += sm;
+    rem += 2 * dn;
+    if (rem >= 2 * dm) {
+      rem -= 2 * dm;
+      n += sn;
+    }
+  }
+  // 画出部分的两端
+  cx0 = steep ? n_first : m_first;
+  cy0 = steep ? m_first : n_first;
+  cx1 = steep ? n : m;
+  cy1 = steep ? m : n;
+  OLEDH_MARK_DIRTY(phandle, cx0 < cx1 ? cx0 : cx1, cx0 < cx1 ? cx1 : cx0, (cy0 < cy1 ? cy0 : cy1) >> 3,
+                  (cy0 < cy1 ? cy1 : cy0) >> 3);
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLEDH_Draw_Circle(OLED_HandleTypeDef *phandle, int16_t xc, int16_t yc, int16_t radius, uint8_t state)
+{
+  if (radius < 0) return OLED_OUT_RANGE;
+  OLEDH_PHYS_POINT(phandle, xc, yc);  // 圆旋转后不变，只换算圆心
+  int16_t left = xc - radius, right = xc + radius, top = yc - radius, bottom = yc + radius;
+  if (right < 0 || bottom < 0 || left >= phandle->width || top >= phandle->height) return OLED_OUT_RANGE;
+  // 整个圆都在屏幕内时不需要逐点检查
+  uint8_t inside = left >= 0 && top >= 0 && right < phandle->width && bottom < phandle->height;
+
+  int16_t x = radius, y = 0, err = 1 - radius;
+  while (x >= y) {
+    const int16_t px[8] = {xc + x, xc - x, xc + x, xc - x, xc + y, xc - y, xc + y, xc - y};
+    const int16_t py[8] = {yc + y, yc + y, yc - y, yc - y, yc + x, yc + x, yc - x, yc - x};
+    for (uint8_t i = 0; i < 8; ++i) {
+      if (!inside && (px[i] < 0 || py[i] < 0 || px[i] >= phandle->width || py[i] >= phandle->height)) continue;
+      OLED_PLOT(phandle, px[i], py[i], state);
+    }
+    y++;
+    if (err < 0) {
+      err += 2 * y + 1;
+    } else {
+      x--;
+      err += 2 * (y - x) + 1;
+    }
+  }
+  if (left < 0) left = 0;
+  if (top < 0) top = 0;
+  if (right >= phandle->width) right = phandle->width - 1;
+  if (bottom >= phandle->height) bottom = phandle->height - 1;
+  OLEDH_MARK_DIRTY(phandle, left, right, top >> 3, bottom >> 3);
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLEDH_Fill_Circle(OLED_HandleTypeDef *phandle, int16_t xc, int16_t yc, int16_t radius, uint8_t state)
+{
+  if (radius < 0) return OLED_OUT_RANGE;
+  if (xc + radius < 0 || yc + radius < 0 || xc - radius >= OLEDH_WIDTH(phandle) ||
+      yc - radius >= OLEDH_HEIGHT(phandle))
+    return OLED_OUT_RANGE;
+
+  int16_t x = radius, y = 0, err = 1 - radius;
+  while (x >= y) {
+    // 每一步得到上下对称的四条水平线，y与x相等时两组重合只画一次
+    OLEDH_Draw_HLine(phandle, xc - x, yc + y, 2 * x + 1, state);
+    if (y) OLEDH_Draw_HLine(phandle, xc - x, yc - y, 2 * x + 1, state);
+    if (x != y) {
+      OLEDH_Draw_HLine(phandle, xc - y, yc + x, 2 * y + 1, state);
+      OLEDH_Draw_HLine(phandle, xc - y, yc - x, 2 * y + 1, state);
+    }
+    y++;
+    if (err < 0) {
+      err += 2 * y + 1;
+    } else {
+      x--;
+      err += 2 * (y - x) + 1;
+    }
+  }
+  return OLED_OK;
+}
+
+/**
+ * 位图一页中的一段列写入目标缓存
+ * @note bits为源字节左移shift后的16位值，低8位写入plow所在页，高8位写入phigh所在页
+ */
+#define OLED_BLIT_LOOP(OP)                                                    \
+  for (uint16_t i = 0; i < count; ++i) {                                      \
+    uint16_t bits = (uint16_t)(psrc[i] & valid) << shift;                     \
+    if (plow) OP(plow[i], (uint8_t)bits, mask_low);                           \
+    if (phigh) OP(phigh[i], (uint8_t)(bits >> 8), mask_high);                 \
+  }
+#define OLED_ROP_COPY_OP(dst, bits, mask) dst = (dst & ~(mask)) | (bits)
+#define OLED_ROP_OR_OP(dst, bits, mask) dst |= (bits)
+#define OLED_ROP_AND_NOT_OP(dst, bits, mask) dst &= ~(bits)
+#define OLED_ROP_XOR_OP(dst, bits, mask) dst ^= (bits)
+
+#if OLED_SWAP_AXES
+/**
+ * 旋转90/270度时位图的一列落在显存某一页中的一行上
+ * @note 每一列只换算一次坐标得到页内位掩码和起始字节，沿位图向下每走一个点显存指针移动一列
+ */
+#  define OLED_BLIT_ROTATED_LOOP(OP)                                                      \
+    for (int16_t row = row_start; row <= row_end; ++row, pdst += OLED_PHYS_ROW_STEP) {    \
+      if (0 == (row & 7) && row != row_start) bits = *(psrc += width);                    \
+      OP(*pdst, bits & 1, mask);                                                          \
+      bits >>= 1;                                                                         \
+    }
+#  define OLED_PIXEL_COPY_OP(dst, on, mask) \
+    if (on)                                 \
+      dst |= (mask);                        \
+    else                                    \
+      dst &= ~(mask)
+#  define OLED_PIXEL_OR_OP(dst, on, mask) \
+    if (on) dst |= (mask)
+#  define OLED_PIXEL_AND_NOT_OP(dst, on, mask) \
+    if (on) dst &= ~(mask)
+#  define OLED_PIXEL_XOR_OP(dst, on, mask) \
+    if (on) dst ^= (mask)
+
+OLED_StatusTypeDef OLEDH_Draw_Bitmap(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                                     const uint8_t *pbitmap, OLED_RopTypeDef rop)
+{
+  if (0 == width || 0 == height) return OLED_OUT_RANGE;
+  int16_t column_start = x < 0 ? -x : 0, row_start = y < 0 ? -y : 0;
+  int16_t column_end = x + width - 1 >= OLEDH_WIDTH(phandle) ? OLEDH_WIDTH(phandle) - 1 - x : width - 1;
+  int16_t row_end = y + height - 1 >= OLEDH_HEIGHT(phandle) ? OLEDH_HEIGHT(phandle) - 1 - y : height - 1;
+  if (column_start > column_end || row_start > row_end) return OLED_OUT_RANGE;
+
+  for (int16_t column = column_start; column <= column_end; ++column) {
+    int16_t phys_x = OLEDH_PHYS_X(phandle, x + column, y + row_start);
+    int16_t phys_y = OLEDH_PHYS_Y(phandle, x + column, y + row_start);
+    uint8_t *pdst = &phandle->pbuffer[(phys_y >> 3) * phandle->width + phys_x];
+    uint8_t mask = 1 << (phys_y & 7);
+    const uint8_t *psrc = pbitmap + (row_start >> 3) * width + column;
+    uint8_t bits = *psrc >> (row_start & 7);
+    switch (rop) {
+      case OLED_ROP_OR: OLED_BLIT_ROTATED_LOOP(OLED_PIXEL_OR_OP); break;
+      case OLED_ROP_AND_NOT: OLED_BLIT_ROTATED_LOOP(OLED_PIXEL_AND_NOT_OP); break;
+      case OLED_ROP_XOR: OLED_BLIT_ROTATED_LOOP(OLED_PIXEL_XOR_OP); break;
+      default: OLED_BLIT_ROTATED_LOOP(OLED_PIXEL_COPY_OP); break;
+    }
+  }
+
+  int16_t dirty_x = x + column_start, dirty_y = y + row_start;
+  int16_t dirty_width = column_end - column_start + 1, dirty_height = row_end - row_start + 1;
+  OLEDH_PHYS_RECT(phandle, dirty_x, dirty_y, dirty_width, dirty_height);
+  OLEDH_MARK_DIRTY(phandle, dirty_x, dirty_x + dirty_width - 1, dirty_y / 8, (dirty_y + dirty_height - 1) / 8);
+  return OLED_OK;
+}
+#else
+OLED_StatusTypeDef OLEDH_Draw_Bitmap(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                                     const uint8_t *pbitmap, OLED_RopTypeDef rop)
+{
+  if (0 == width || 0 == height) return OLED_OUT_RANGE;
+  int16_t x_start = x < 0 ? 0 : x;
+  int16_t x_end = x + width - 1 >= phandle->width ? phandle->width - 1 : x + width - 1;
+  if (x_start > x_end || y >= phandle->height || y + height <= 0) return OLED_OUT_RANGE;
+
+  uint8_t shift = y & 7;
+  int16_t page_base = (y - shift) / 8;  // 负数时向下取整
+  uint8_t src_pages = (height + 7) / 8;
+  uint16_t count = x_end - x_start + 1;
+  for (uint8_t src_page = 0; src_page < src_pages; ++src_page) {
+    const uint8_t *psrc = pbitmap + src_page * width + (x_start - x);
+    uint8_t valid = (src_page == src_pages - 1 && (height & 7)) ? 0xff >> (8 - (height & 7)) : 0xff;
+    uint8_t mask_low = (uint8_t)(valid << shift), mask_high = (uint8_t)((uint16_t)valid << shift >> 8);
+    int16_t page = page_base + src_page;
+    uint8_t *plow = NULL, *phigh = NULL;
+    if (page >= 0 && page < phandle->pages && mask_low) plow = &phandle->pbuffer[page * phandle->width + x_start];
+    if (page + 1 >= 0 && page + 1 < phandle->pages && mask_high)
+      phigh = &phandle->pbuffer[(page + 1) * phandle->width + x_start];
+    switch (rop) {
+      case OLED_ROP_OR: OLED_BLIT_LOOP(OLED_ROP_OR_OP); break;
+      case OLED_ROP_AND_NOT: OLED_BLIT_LOOP(OLED_ROP_AND_NOT_OP); break;
+      case OLED_ROP_XOR: OLED_BLIT_LOOP(OLED_ROP_XOR_OP); break;
+      default: OLED_BLIT_LOOP(OLED_ROP_COPY_OP); break;
+    }
+  }
+
+  OLEDH_MARK_DIRTY(phandle, x_start, x_end, y < 0 ? 0 : y / 8, (y + height - 1) / 8);
+  return OLED_OK;
+}
+#endif
+
+OLED_StatusTypeDef OLED_Draw_HLine(int16_t x, int16_t y, int16_t width, uint8_t state)
+{
+  return OLEDH_Draw_HLine(&g_oled_handle, x, y, width, state);
+}
+
+OLED_StatusTypeDef OLED_Draw_VLine(int16_t x, int16_t y, int16_t height, uint8_t state)
+{
+  return OLEDH_Draw_VLine(&g_oled_handle, x, y, height, state);
+}
+
+OLED_StatusTypeDef OLED_Draw_Line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t state)
+{
+  return OLEDH_Draw_Line(&g_oled_handle, x0, y0, x1, y1, state);
+}
+
+OLED_StatusTypeDef OLED_Draw_Rect(int16_t x, int16_t y, int16_t width, int16_t height, uint8_t state)
+{
+  return OLEDH_Draw_Rect(&g_oled_handle, x, y, width, height, state);
+}
+
+OLED_StatusTypeDef OLED_Fill_Rect(int16_t x, int16_t y, int16_t width, int16_t height, uint8_t state)
+{
+  return OLEDH_Fill_Rect(&g_oled_handle, x, y, width, height, state);
+}
+
+OLED_StatusTypeDef OLED_Draw_Circle(int16_t xc, int16_t yc, int16_t radius, uint8_t state)
+{
+  return OLEDH_Draw_Circle(&g_oled_handle, xc, yc, radius, state);
+}
+
+OLED_StatusTypeDef OLED_Fill_Circle(int16_t xc, int16_t yc, int16_t radius, uint8_t state)
+{
+  return OLEDH_Fill_Circle(&g_oled_handle, xc, yc, radius, state);
+}
+
+OLED_StatusTypeDef OLED_Draw_Bitmap(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *pbitmap,
+                                    OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_Bitmap(&g_oled_handle, x, y, width, height, pbitmap, rop);
+}
@@ -0,0 +1,131 @@
+/**
+ * @Description OLED基本图形绘制，直接按页存储的格式操作实例的显存
+ * @Author jinming xi
+ * @Date 2022/11/3
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDGRAPHICS_H
+#define OLEDGRAPHICS_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+/**
+ * @note 以下函数的坐标都可以超出屏幕，超出部分在绘制前一次性裁剪掉
+ * @note state 点亮为1，熄灭为0
+ * @note 图形完全在屏幕外时返回OLED_OUT_RANGE
+ * @note 坐标为OLED_ROTATION旋转后的绘图坐标，进入函数时一次换算成显存坐标
+ */
+
+/**
+ * 画水平线，每一列只需要一次按位或/与
+ * @param x 起点横坐标
+ * @param y 纵坐标
+ * @param width 长度
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_HLine(int16_t x, int16_t y, int16_t width, uint8_t state);
+
+/**
+ * 画竖直线，每一页一次写入8个点
+ * @param x 横坐标
+ * @param y 起点纵坐标
+ * @param height 长度
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_VLine(int16_t x, int16_t y, int16_t height, uint8_t state);
+
+/**
+ * 画任意直线(Bresenham)，水平线和竖直线自动走快速路径
+ * @param x0 起点横坐标
+ * @param y0 起点纵坐标
+ * @param x1 终点横坐标
+ * @param y1 终点纵坐标
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_Line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t state);
+
+/**
+ * 画矩形边框
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 宽度
+ * @param height 高度
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_Rect(int16_t x, int16_t y, int16_t width, int16_t height, uint8_t state);
+
+/**
+ * 填充矩形，整页覆盖的部分直接memset
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 宽度
+ * @param height 高度
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Fill_Rect(int16_t x, int16_t y, int16_t width, int16_t height, uint8_t state);
+
+/**
+ * 画圆(中点画圆法)
+ * @param xc 圆心横坐标
+ * @param yc 圆心纵坐标
+ * @param radius 半径
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_Circle(int16_t xc, int16_t yc, int16_t radius, uint8_t state);
+
+/**
+ * 填充圆，逐行画水平线
+ * @param xc 圆心横坐标
+ * @param yc 圆心纵坐标
+ * @param radius 半径
+ * @param state 点的状态
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Fill_Circle(int16_t xc, int16_t yc, int16_t radius, uint8_t state);
+
+/**
+ * 在任意像素位置绘制按页存储的位图
+ * @note 位图格式与g_oled_buffer相同: 每字节为一列中的8个点，低位在上，一页width个字节，共(height + 7) / 8页
+ * @note 纵坐标不对齐时每个字节拆成上下两页的两部分写入
+ * @param x 左上角横坐标，可以为负
+ * @param y 左上角纵坐标，可以为负
+ * @param width 位图宽度
+ * @param height 位图高度
+ * @param pbitmap 位图数据
+ * @param rop 光栅操作
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_Bitmap(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t *pbitmap,
+                                    OLED_RopTypeDef rop);
+
+/**
+ * @brief 多实例接口，第一个参数为屏幕实例，其余参数与返回值同上面不带句柄的同名函数
+ */
+OLED_StatusTypeDef OLEDH_Draw_HLine(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t width, uint8_t state);
+OLED_StatusTypeDef OLEDH_Draw_VLine(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t height, uint8_t state);
+OLED_StatusTypeDef OLEDH_Draw_Line(OLED_HandleTypeDef *phandle, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                   uint8_t state);
+OLED_StatusTypeDef OLEDH_Draw_Rect(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t width, int16_t height,
+                                   uint8_t state);
+OLED_StatusTypeDef OLEDH_Fill_Rect(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, int16_t width, int16_t height,
+                                   uint8_t state);
+OLED_StatusTypeDef OLEDH_Draw_Circle(OLED_HandleTypeDef *phandle, int16_t xc, int16_t yc, int16_t radius,
+                                     uint8_t state);
+OLED_StatusTypeDef OLEDH_Fill_Circle(OLED_HandleTypeDef *phandle, int16_t xc, int16_t yc, int16_t radius,
+                                     uint8_t state);
+OLED_StatusTypeDef OLEDH_Draw_Bitmap(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                                     const uint8_t *pbitmap, OLED_RopTypeDef rop);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDGRAPHICS_H
@@ -0,0 +1,151 @@
+/**
+ * @Description 4级灰度，两个位面按2:1的时间比例轮流显示，只有含中间灰度的区域需要反复发送
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDGray.h"
+#include "OLEDGraphics.h"
+
+#define OLED_GRAY_LOW 0   // 低位面
+#define OLED_GRAY_HIGH 1  // 高位面
+
+void OLED_Gray_Init(OLED_GrayTypeDef *pgray, OLED_HandleTypeDef *phandle, uint8_t *plow, uint8_t *phigh)
+{
+  uint16_t size = phandle->width * phandle->pages;
+  pgray->phandle = phandle;
+  pgray->pplanes[OLED_GRAY_LOW] = plow;
+  pgray->pplanes[OLED_GRAY_HIGH] = phigh;
+  pgray->pbuffer = phandle->pbuffer;
+  pgray->phase = 0;
+  memset(pgray->gray_start, 0xff, sizeof(pgray->gray_start));
+  memset(pgray->gray_end, 0, sizeof(pgray->gray_end));
+  memset(&pgray->stats, 0, sizeof(OLED_GrayStatsTypeDef));
+  memcpy(plow, phandle->pbuffer, size);
+  memcpy(phigh, phandle->pbuffer, size);
+  phandle->pbuffer = phigh;
+}
+
+void OLED_Gray_Deinit(OLED_GrayTypeDef *pgray)
+{
+  OLED_HandleTypeDef *phandle = pgray->phandle;
+  memcpy(pgray->pbuffer, pgray->pplanes[OLED_GRAY_HIGH], phandle->width * phandle->pages);
+  phandle->pbuffer = pgray->pbuffer;
+  OLEDH_MARK_ALL_DIRTY(phandle);
+}
+
+OLED_StatusTypeDef OLED_Gray_Tick(OLED_GrayTypeDef *pgray)
+{
+  OLED_HandleTypeDef *phandle = pgray->phandle;
+  OLED_StatusTypeDef status;
+  pgray->stats.ticks++;
+  if (1 == pgray->phase) {
+    pgray->phase = 2;  // 高位面的第二个Tick，保持不变
+    return OLED_OK;
+  }
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == OLEDH_Get_Refresh_State(phandle)) {
+    pgray->stats.overruns++;
+    return OLED_BUSY;
+  }
+#endif
+  // 两个位面只在含中间灰度的区域不同，切换后只需要发送这些区域
+  phandle->pbuffer = pgray->pplanes[0 == pgray->phase ? OLED_GRAY_HIGH : OLED_GRAY_LOW];
+  for (uint8_t page = 0; page < phandle->pages; ++page) {
+    if (pgray->gray_start[page] <= pgray->gray_end[page]) {
+      OLEDH_MARK_DIRTY(phandle, pgray->gray_start[page], pgray->gray_end[page], page, page);
+    }
+  }
+#ifdef OLED_USING_DMA_TRANSMIT
+  status = OLEDH_Refresh_Async(phandle);
+#else
+  status = OLEDH_Refresh_GSRAM(phandle);
+#endif
+  pgray->stats.switches++;
+  if (OLED_OK != status) pgray->stats.errors++;
+  pgray->phase = 0 == pgray->phase ? 1 : 0;
+  return status;
+}
+
+void OLED_Gray_Get_Plane(const OLED_GrayTypeDef *pgray, uint8_t plane, OLED_HandleTypeDef *pplane_handle)
+{
+  memset(pplane_handle, 0, sizeof(OLED_HandleTypeDef));
+  pplane_handle->pbuffer = pgray->pplanes[plane ? OLED_GRAY_HIGH : OLED_GRAY_LOW];
+  pplane_handle->width = pgray->phandle->width;
+  pplane_handle->height = pgray->phandle->height;
+  pplane_handle->pages = pgray->phandle->pages;
+}
+
+/**
+ * 把一块绘制区域换算到显存坐标并裁剪，标记实例需要刷新，含中间灰度时扩大对应页的灰度范围
+ * @param pgray 灰度显示
+ * @param gray 区域内可能有中间灰度
+ */
+static void OLED_Gray_Touch(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, int16_t width, int16_t height, uint8_t gray)
+{
+  OLED_HandleTypeDef *phandle = pgray->phandle;
+  OLEDH_PHYS_RECT(phandle, x, y, width, height);
+  int16_t x_start = x < 0 ? 0 : x, x_end = x + width - 1 >= phandle->width ? phandle->width - 1 : x + width - 1;
+  int16_t y_start = y < 0 ? 0 : y, y_end = y + height - 1 >= phandle->height ? phandle->height - 1 : y + height - 1;
+  if (width <= 0 || height <= 0 || x_start > x_end || y_start > y_end) return;
+  OLEDH_MARK_DIRTY(phandle, x_start, x_end, y_start / 8, y_end / 8);
+  if (!gray) return;
+  for (uint8_t page = y_start / 8; page <= y_end / 8; ++page) {
+    if (pgray->gray_start[page] > x_start) pgray->gray_start[page] = x_start;
+    if (pgray->gray_end[page] < x_end) pgray->gray_end[page] = x_end;
+  }
+}
+
+OLED_StatusTypeDef OLED_Gray_Set_Pixel(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, uint8_t level)
+{
+  if (x < 0 || y < 0 || x >= OLEDH_WIDTH(pgray->phandle) || y >= OLEDH_HEIGHT(pgray->phandle)) return OLED_OUT_RANGE;
+  OLED_Gray_Touch(pgray, x, y, 1, 1, 1 == level || 2 == level);
+  OLEDH_PHYS_POINT(pgray->phandle, x, y);
+  uint16_t index = (y / 8) * pgray->phandle->width + x;
+  uint8_t bit = 1 << (y & 7);
+  for (uint8_t plane = 0; plane < 2; ++plane) {
+    if (level >> plane & 1)
+      pgray->pplanes[plane][index] |= bit;
+    else
+      pgray->pplanes[plane][index] &= ~bit;
+  }
+  return OLED_OK;
+}
+
+void OLED_Gray_Fill_Rect(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, int16_t width, int16_t height,
+                         uint8_t level)
+{
+  OLED_HandleTypeDef plane_handle;
+  for (uint8_t plane = 0; plane < 2; ++plane) {
+    OLED_Gray_Get_Plane(pgray, plane, &plane_handle);
+    OLEDH_Fill_Rect(&plane_handle, x, y, width, height, level >> plane & 1);
+  }
+  OLED_Gray_Touch(pgray, x, y, width, height, 1 == level || 2 == level);
+}
+
+void OLED_Gray_Draw_Bitmap(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                           const uint8_t *pbitmap)
+{
+  OLED_HandleTypeDef plane_handle;
+  uint16_t plane_size = width * ((height + 7) / 8);
+  for (uint8_t plane = 0; plane < 2; ++plane) {
+    OLED_Gray_Get_Plane(pgray, plane, &plane_handle);
+    OLEDH_Draw_Bitmap(&plane_handle, x, y, width, height, pbitmap + plane * plane_size, OLED_ROP_COPY);
+  }
+  OLED_Gray_Touch(pgray, x, y, width, height, 1);
+}
+
+void OLED_Gray_Update(OLED_GrayTypeDef *pgray)
+{
+  OLED_HandleTypeDef *phandle = pgray->phandle;
+  const uint8_t *plow = pgray->pplanes[OLED_GRAY_LOW], *phigh = pgray->pplanes[OLED_GRAY_HIGH];
+  for (uint8_t page = 0; page < phandle->pages; ++page) {
+    uint16_t base = page * phandle->width;
+    int16_t start = 0, end = phandle->width - 1;
+    while (start <= end && plow[base + start] == phigh[base + start]) ++start;
+    while (end > start && plow[base + end] == phigh[base + end]) --end;
+    pgray->gray_start[page] = start <= end ? start : 0xff;
+    pgray->gray_end[page] = start <= end ? end : 0;
+  }
+  OLEDH_MARK_ALL_DIRTY(phandle);
+}
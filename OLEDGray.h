@@ -0,0 +1,122 @@
+/**
+ * @Description 4级灰度，两个位面按2:1的时间比例轮流显示，只有含中间灰度的区域需要反复发送
+ * @note 高位面显示2个Tick，低位面显示1个Tick，灰度 = (2 * 高位 + 低位) / 3
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDGRAY_H
+#define OLEDGRAY_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+#define OLED_GRAY_LEVELS 4  // 灰度级数，0为熄灭，3为全亮
+#define OLED_GRAY_PHASES 3  // 一个灰度周期的Tick数，其中2次需要切换位面并刷新
+
+/**
+ * @brief 灰度调度的统计
+ */
+typedef struct {
+  uint32_t ticks;     // OLED_Gray_Tick的调用次数
+  uint32_t switches;  // 切换位面并刷新的次数
+  uint32_t overruns;  // 上一个位面还没发完而推迟切换的次数
+  uint32_t errors;    // 刷新失败的次数
+} OLED_GrayStatsTypeDef;
+
+/**
+ * @brief 灰度显示
+ * @note 位面的格式与显存相同，实例的pbuffer在两个位面之间切换，不做拷贝
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;             // 显示的屏幕实例
+  uint8_t *pplanes[2];                     // [0]低位面(权重1)，[1]高位面(权重2)，大小与显存相同
+  uint8_t *pbuffer;                        // 开始灰度显示前实例的显存，结束时恢复
+  uint8_t phase;                           // 在灰度周期中的位置
+  uint8_t gray_start[OLED_MAX_PAGE_SIZE];  // 每一页两个位面可能不同的列范围，start > end表示整页没有中间灰度
+  uint8_t gray_end[OLED_MAX_PAGE_SIZE];
+  OLED_GrayStatsTypeDef stats;             // 统计
+} OLED_GrayTypeDef;
+
+/**
+ * 开始灰度显示，两个位面都从实例当前的显存内容开始(只有0和3两级)
+ * @param pgray 灰度显示
+ * @param phandle 屏幕实例
+ * @param plow 低位面，大小与实例的显存相同
+ * @param phigh 高位面
+ */
+void OLED_Gray_Init(OLED_GrayTypeDef *pgray, OLED_HandleTypeDef *phandle, uint8_t *plow, uint8_t *phigh);
+
+/**
+ * 结束灰度显示，恢复实例原来的显存，灰度2、3的点点亮，其余熄灭
+ * @note 定义OLED_USING_DMA_TRANSMIT时需要先等待刷新结束
+ * @param pgray 灰度显示
+ */
+void OLED_Gray_Deinit(OLED_GrayTypeDef *pgray);
+
+/**
+ * 灰度调度，由定时器按固定周期调用，每3次中有2次切换位面并刷新
+ * @note 定义OLED_USING_PARTIAL_REFRESH时只发送含中间灰度的区域和其它改动，否则每次切换都整屏发送
+ * @note 定义OLED_USING_DMA_TRANSMIT时发起异步刷新后立即返回
+ * @param pgray 灰度显示
+ * @return 上一个位面还在发送时返回OLED_BUSY并推迟到下一次调用
+ */
+OLED_StatusTypeDef OLED_Gray_Tick(OLED_GrayTypeDef *pgray);
+
+/**
+ * 画点
+ * @param pgray 灰度显示
+ * @param x 横坐标
+ * @param y 纵坐标
+ * @param level 灰度 0~3
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Gray_Set_Pixel(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, uint8_t level);
+
+/**
+ * 填充矩形
+ * @param pgray 灰度显示
+ * @param x 左上角横坐标，可以为负
+ * @param y 左上角纵坐标，可以为负
+ * @param width 宽度
+ * @param height 高度
+ * @param level 灰度 0~3
+ */
+void OLED_Gray_Fill_Rect(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, int16_t width, int16_t height,
+                         uint8_t level);
+
+/**
+ * 绘制2位灰度位图，例如抗锯齿的文字或图标
+ * @note 位图先存低位面再存高位面，每个位面的格式与OLED_Draw_Bitmap相同，共2 * width * ((height + 7) / 8)字节
+ * @param pgray 灰度显示
+ * @param x 左上角横坐标，可以为负
+ * @param y 左上角纵坐标，可以为负
+ * @param width 宽度
+ * @param height 高度
+ * @param pbitmap 位图
+ */
+void OLED_Gray_Draw_Bitmap(OLED_GrayTypeDef *pgray, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                           const uint8_t *pbitmap);
+
+/**
+ * 取得绘制某个位面用的实例，可以用OLEDGraphics.h、OLEDFont.h等所有绘图函数直接在位面上绘制
+ * @note 这样绘制之后需要调用OLED_Gray_Update
+ * @param pgray 灰度显示
+ * @param plane 0->低位面;1->高位面
+ * @param pplane_handle 输出的实例，只用于绘制，不能刷新
+ */
+void OLED_Gray_Get_Plane(const OLED_GrayTypeDef *pgray, uint8_t plane, OLED_HandleTypeDef *pplane_handle);
+
+/**
+ * 重新扫描含中间灰度的区域，并标记整屏需要刷新
+ * @note 直接修改位面之后调用；中间灰度的区域变小后调用也可以减少之后每次切换的发送量
+ * @param pgray 灰度显示
+ */
+void OLED_Gray_Update(OLED_GrayTypeDef *pgray);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDGRAY_H
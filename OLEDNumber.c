@@ -0,0 +1,97 @@
+/**
+ * @Description 数字显示，不经过printf与字符串，把数字逐位换算成字形直接绘制，只重绘变化的字符格
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDNumber.h"
+#include "OLEDGraphics.h"
+
+#define OLED_NUMBER_OVERFLOW '#'  // 区域放不下时每一格显示的字符
+
+void OLED_Number_Init(OLED_NumberTypeDef *pnum, OLED_HandleTypeDef *phandle, int16_t x, int16_t y,
+                      const OLED_FontTypeDef *pfont, uint8_t cells, uint8_t flags)
+{
+  OLED_GlyphInfoTypeDef info;
+  memset(pnum, 0, sizeof(OLED_NumberTypeDef));
+  pnum->phandle = NULL != phandle ? phandle : &g_oled_handle;
+  pnum->pfont = pfont;
+  pnum->x = x;
+  pnum->y = y;
+  pnum->cells = cells > OLED_NUMBER_MAX_CELLS ? OLED_NUMBER_MAX_CELLS : cells;
+  pnum->cell_width = OLED_OK == OLED_Font_Get_Glyph(pfont, '0', &info) ? info.advance : pfont->height / 2;
+  pnum->flags = flags;
+}
+
+/**
+ * 把新的字符与已经绘制的逐格比较，只重绘变化的格
+ * @note 字形比格窄(例如比例字库中的空格)时先清空整格
+ * @param pnum 数字区域
+ * @param pcells 每一格的新字符
+ * @return 重绘的格数
+ */
+static uint8_t OLED_Number_Update(OLED_NumberTypeDef *pnum, const char *pcells)
+{
+  OLED_GlyphInfoTypeDef info;
+  uint8_t redrawn = 0;
+  for (uint8_t i = 0; i < pnum->cells; ++i) {
+    if (pcells[i] == pnum->shown[i]) continue;
+    int16_t x = pnum->x + i * pnum->cell_width;
+    uint8_t found = OLED_OK == OLED_Font_Get_Glyph(pnum->pfont, (uint8_t)pcells[i], &info);
+    if (!found || info.width < pnum->cell_width || info.height < pnum->pfont->height)
+      OLEDH_Fill_Rect(pnum->phandle, x, pnum->y, pnum->cell_width, pnum->pfont->height, 0);
+    if (found) OLEDH_Draw_Bitmap(pnum->phandle, x, pnum->y, info.width, info.height, info.pbitmap, OLED_ROP_COPY);
+    pnum->shown[i] = pcells[i];
+    redrawn++;
+  }
+  pnum->redraws += redrawn;
+  return redrawn;
+}
+
+/**
+ * 所有格显示OLED_NUMBER_OVERFLOW
+ * @param pnum 数字区域
+ * @return 重绘的格数
+ */
+static uint8_t OLED_Number_Overflow(OLED_NumberTypeDef *pnum)
+{
+  char cells[OLED_NUMBER_MAX_CELLS];
+  memset(cells, OLED_NUMBER_OVERFLOW, sizeof(cells));
+  return OLED_Number_Update(pnum, cells);
+}
+
+uint8_t OLED_Number_Set_Fixed(OLED_NumberTypeDef *pnum, int32_t value, uint8_t decimals)
+{
+  char cells[OLED_NUMBER_MAX_CELLS];
+  uint32_t magnitude = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+  char sign = value < 0 ? '-' : (pnum->flags & OLED_NUMBER_PLUS) && value > 0 ? '+' : 0;
+  uint8_t digits = 1, point = 0 != decimals;
+  for (uint32_t rest = magnitude / 10; 0 != rest; rest /= 10) ++digits;
+  if (digits <= decimals) digits = decimals + 1;  // 绝对值小于1时小数点前补一个0
+  if (digits + point + (0 != sign) > pnum->cells) return OLED_Number_Overflow(pnum);
+  if (pnum->flags & OLED_NUMBER_ZERO_PAD) digits = pnum->cells - point - (0 != sign);
+
+  // 从最低位开始向左逐格填入，不生成中间字符串
+  uint8_t end = pnum->flags & OLED_NUMBER_ALIGN_LEFT ? digits + point + (0 != sign) : pnum->cells;
+  memset(cells, ' ', sizeof(cells));
+  for (uint8_t i = 0; i < digits; ++i) {
+    if (point && i == decimals) cells[--end] = '.';
+    cells[--end] = '0' + magnitude % 10;
+    magnitude /= 10;
+  }
+  if (sign) cells[--end] = sign;
+  return OLED_Number_Update(pnum, cells);
+}
+
+uint8_t OLED_Number_Set_Int(OLED_NumberTypeDef *pnum, int32_t value) { return OLED_Number_Set_Fixed(pnum, value, 0); }
+
+uint8_t OLED_Number_Set_Float(OLED_NumberTypeDef *pnum, float value, uint8_t decimals)
+{
+  for (uint8_t i = 0; i < decimals; ++i) value *= 10.0f;
+  value += value < 0 ? -0.5f : 0.5f;
+  // NaN的比较结果总是假，同样按放不下处理
+  if (!(value > -2147483648.0f && value < 2147483648.0f)) return OLED_Number_Overflow(pnum);
+  return OLED_Number_Set_Fixed(pnum, (int32_t)value, decimals);
+}
+
+void OLED_Number_Invalidate(OLED_NumberTypeDef *pnum) { memset(pnum->shown, 0, sizeof(pnum->shown)); }
@@ -0,0 +1,89 @@
+/**
+ * @Description 数字显示，不经过printf与字符串，把数字逐位换算成字形直接绘制，只重绘变化的字符格
+ * @note 1999变为2000时重绘4格，2000变为2001时只重绘1格，重绘通过绘图函数标记脏区
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDNUMBER_H
+#define OLEDNUMBER_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+#include "OLEDFont.h"
+
+#define OLED_NUMBER_MAX_CELLS 16  // 一个数字区域最多的字符格数
+
+#define OLED_NUMBER_ALIGN_LEFT 0x01U  // 左对齐，默认右对齐
+#define OLED_NUMBER_ZERO_PAD 0x02U    // 用0补满整个区域，符号在最左边
+#define OLED_NUMBER_PLUS 0x04U        // 正数也显示'+'
+
+/**
+ * @brief 一个固定宽度的数字显示区域，由用户分配
+ * @note 每一格的宽度为字库中'0'的宽度，区域宽度固定，数值位数变化时布局不动
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;        // 绘制的屏幕实例
+  const OLED_FontTypeDef *pfont;      // 字库
+  int16_t x;                          // 区域左上角横坐标(绘图坐标)
+  int16_t y;                          // 区域左上角纵坐标
+  uint8_t cells;                      // 字符格数
+  uint8_t cell_width;                 // 每格的宽度
+  uint8_t flags;                      // OLED_NUMBER_ALIGN_LEFT等标志的组合
+  char shown[OLED_NUMBER_MAX_CELLS];  // 每一格上已经绘制的字符，0表示还没有绘制
+  uint32_t redraws;                   // 重绘的格数
+} OLED_NumberTypeDef;
+
+/**
+ * 初始化数字区域，不绘制，第一次设置数值时绘制所有格
+ * @param pnum 数字区域
+ * @param phandle 屏幕实例，为NULL时使用默认实例
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param pfont 字库，数字、符号、小数点和空格应等宽，例如g_oled_font_6x8、g_oled_font_8x16
+ * @param cells 字符格数，含符号与小数点，不超过OLED_NUMBER_MAX_CELLS
+ * @param flags OLED_NUMBER_ALIGN_LEFT等标志的组合
+ */
+void OLED_Number_Init(OLED_NumberTypeDef *pnum, OLED_HandleTypeDef *phandle, int16_t x, int16_t y,
+                      const OLED_FontTypeDef *pfont, uint8_t cells, uint8_t flags);
+
+/**
+ * 显示整数
+ * @note 区域放不下时所有格显示'#'
+ * @param pnum 数字区域
+ * @param value 数值
+ * @return 重绘的格数，数值显示不变时为0
+ */
+uint8_t OLED_Number_Set_Int(OLED_NumberTypeDef *pnum, int32_t value);
+
+/**
+ * 显示定点小数，例如value为-1234、decimals为2时显示-12.34，绝对值小于1时补0，例如5、2显示0.05
+ * @param pnum 数字区域
+ * @param value 放大10^decimals倍后的数值
+ * @param decimals 小数位数
+ * @return 重绘的格数
+ */
+uint8_t OLED_Number_Set_Fixed(OLED_NumberTypeDef *pnum, int32_t value, uint8_t decimals);
+
+/**
+ * 显示浮点数，四舍五入到decimals位小数后按定点小数显示，不使用libc的格式化函数
+ * @note 放大后超出int32_t范围或者为NaN时所有格显示'#'
+ * @param pnum 数字区域
+ * @param value 数值
+ * @param decimals 小数位数
+ * @return 重绘的格数
+ */
+uint8_t OLED_Number_Set_Float(OLED_NumberTypeDef *pnum, float value, uint8_t decimals);
+
+/**
+ * 标记所有格需要重绘，例如整屏被其它内容覆盖之后，下一次设置数值时绘制所有格
+ * @param pnum 数字区域
+ */
+void OLED_Number_Invalidate(OLED_NumberTypeDef *pnum);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDNUMBER_H
@@ -0,0 +1,96 @@
+/**
+ * @Description 操作系统抽象层，为渲染队列提供信号量和原子操作
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#if defined(OLED_OS_POSIX) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 200112L  // -std=c99/c11下不声明clock_gettime与pthread_cond_timedwait
+#endif
+#include "OLEDOS.h"
+
+#if defined(OLED_OS_FREERTOS)
+int OLED_OS_Sem_Create(OLED_OSSemTypeDef *psem)
+{
+  psem->handle = xSemaphoreCreateBinaryStatic(&psem->storage);
+  return NULL == psem->handle ? -1 : 0;
+}
+
+void OLED_OS_Sem_Give(OLED_OSSemTypeDef *psem) { xSemaphoreGive(psem->handle); }
+
+void OLED_OS_Sem_Give_ISR(OLED_OSSemTypeDef *psem)
+{
+  BaseType_t woken = pdFALSE;
+  xSemaphoreGiveFromISR(psem->handle, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+uint8_t OLED_OS_Sem_Take(OLED_OSSemTypeDef *psem, uint32_t timeout)
+{
+  TickType_t ticks = OLED_OS_WAIT_FOREVER == timeout ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+  return pdTRUE == xSemaphoreTake(psem->handle, ticks);
+}
+
+#elif defined(OLED_OS_POSIX)
+#  include <time.h>
+
+int OLED_OS_Sem_Create(OLED_OSSemTypeDef *psem)
+{
+  psem->flag = 0;
+  if (0 != pthread_mutex_init(&psem->mutex, NULL)) return -1;
+  return pthread_cond_init(&psem->cond, NULL);
+}
+
+void OLED_OS_Sem_Give(OLED_OSSemTypeDef *psem)
+{
+  pthread_mutex_lock(&psem->mutex);
+  psem->flag = 1;
+  pthread_cond_signal(&psem->cond);
+  pthread_mutex_unlock(&psem->mutex);
+}
+
+void OLED_OS_Sem_Give_ISR(OLED_OSSemTypeDef *psem) { OLED_OS_Sem_Give(psem); }  // 主机上用另一个线程模拟中断
+
+uint8_t OLED_OS_Sem_Take(OLED_OSSemTypeDef *psem, uint32_t timeout)
+{
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += timeout / 1000;
+  deadline.tv_nsec += (long)(timeout % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  pthread_mutex_lock(&psem->mutex);
+  int result = 0;
+  while (!psem->flag && 0 == result) {
+    if (OLED_OS_WAIT_FOREVER == timeout)
+      result = pthread_cond_wait(&psem->cond, &psem->mutex);
+    else
+      result = pthread_cond_timedwait(&psem->cond, &psem->mutex, &deadline);
+  }
+  uint8_t taken = psem->flag;
+  psem->flag = 0;
+  pthread_mutex_unlock(&psem->mutex);
+  return taken;
+}
+
+#else
+int OLED_OS_Sem_Create(OLED_OSSemTypeDef *psem)
+{
+  psem->flag = 0;
+  return 0;
+}
+
+void OLED_OS_Sem_Give(OLED_OSSemTypeDef *psem) { psem->flag = 1; }
+
+void OLED_OS_Sem_Give_ISR(OLED_OSSemTypeDef *psem) { psem->flag = 1; }
+
+uint8_t OLED_OS_Sem_Take(OLED_OSSemTypeDef *psem, uint32_t timeout)
+{
+  (void)timeout;
+  if (!psem->flag) return 0;
+  psem->flag = 0;  // 中断在检查与清零之间置位时，它对应的命令已经入队，会在这一轮一起处理
+  return 1;
+}
+#endif
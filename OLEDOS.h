@@ -0,0 +1,86 @@
+/**
+ * @Description 操作系统抽象层，为渲染队列提供信号量和原子操作
+ * @note 定义OLED_OS_FREERTOS时使用FreeRTOS的二值信号量，定义OLED_OS_POSIX时使用pthread(主机端测试)，都不定义时为裸机轮询
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDOS_H
+#define OLEDOS_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include <stdint.h>
+#if defined(OLED_OS_FREERTOS)
+#  include "FreeRTOS.h"
+#  include "semphr.h"
+#elif defined(OLED_OS_POSIX)
+#  include <pthread.h>
+#endif
+
+#define OLED_OS_WAIT_FOREVER 0xffffffffU  // 一直等待
+
+/**
+ * @brief 原子操作，GCC/Clang(含ARM Compiler 6)使用内建函数，其它编译器需要在包含本文件前自行定义
+ * @note Cortex-M0没有LDREX/STREX，GCC会生成__atomic_compare_exchange_4调用，需要用关中断的方式实现它
+ */
+#ifndef OLED_OS_ATOMIC_LOAD
+#  if defined(__GNUC__) || defined(__clang__)
+#    define OLED_OS_ATOMIC_LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#    define OLED_OS_ATOMIC_STORE(p, value) __atomic_store_n(p, value, __ATOMIC_RELEASE)
+#    define OLED_OS_ATOMIC_CAS(p, pexpected, desired) \
+      __atomic_compare_exchange_n(p, pexpected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#  else
+#    error "OLED_OS_ATOMIC_LOAD/OLED_OS_ATOMIC_STORE/OLED_OS_ATOMIC_CAS need to be defined for this compiler"
+#  endif
+#endif
+
+/**
+ * @brief 二值信号量，多次释放只保留一次
+ */
+typedef struct {
+#if defined(OLED_OS_FREERTOS)
+  SemaphoreHandle_t handle;   // 信号量句柄
+  StaticSemaphore_t storage;  // 静态分配的信号量
+#elif defined(OLED_OS_POSIX)
+  pthread_mutex_t mutex;  // 保护flag
+  pthread_cond_t cond;    // flag置位时通知
+  uint8_t flag;           // 信号量的值
+#else
+  volatile uint8_t flag;  // 信号量的值
+#endif
+} OLED_OSSemTypeDef;
+
+/**
+ * 创建信号量，初始值为0
+ * @param psem 信号量
+ * @return 成功返回0
+ */
+int OLED_OS_Sem_Create(OLED_OSSemTypeDef *psem);
+
+/**
+ * 释放信号量，只能在任务中调用
+ * @param psem 信号量
+ */
+void OLED_OS_Sem_Give(OLED_OSSemTypeDef *psem);
+
+/**
+ * 在中断里释放信号量
+ * @param psem 信号量
+ */
+void OLED_OS_Sem_Give_ISR(OLED_OSSemTypeDef *psem);
+
+/**
+ * 获取信号量
+ * @note 裸机时不等待，只检查一次
+ * @param psem 信号量
+ * @param timeout 最长等待时间(毫秒)，OLED_OS_WAIT_FOREVER为一直等待
+ * @return 获取到返回1，超时返回0
+ */
+uint8_t OLED_OS_Sem_Take(OLED_OSSemTypeDef *psem, uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDOS_H
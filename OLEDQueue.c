@@ -0,0 +1,191 @@
+/**
+ * @Description 渲染队列，任意任务或中断无锁地投递绘制命令，由唯一的显示任务取出执行并刷新
+ * @note 有界MPMC环形队列(每格一个序号)的单消费者版本，生产者之间只在写入位置上用CAS竞争
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDQueue.h"
+#include "OLEDGraphics.h"
+
+#if 0 != (OLED_QUEUE_LENGTH & (OLED_QUEUE_LENGTH - 1))
+#  error "OLED_QUEUE_LENGTH must be a power of 2"
+#endif
+
+OLED_StatusTypeDef OLED_Queue_Init(OLED_QueueTypeDef *pqueue, OLED_HandleTypeDef *phandle)
+{
+  pqueue->phandle = phandle;
+  for (uint32_t i = 0; i < OLED_QUEUE_LENGTH; ++i) pqueue->slots[i].sequence = i;
+  pqueue->tail = 0;
+  pqueue->head = 0;
+  pqueue->overflows = 0;
+  pqueue->stalled = 0;
+  return 0 == OLED_OS_Sem_Create(&pqueue->sem) ? OLED_OK : OLED_ERROR;
+}
+
+OLED_StatusTypeDef OLED_Queue_Post(OLED_QueueTypeDef *pqueue, const OLED_QueueCmdTypeDef *pcmd)
+{
+  uint32_t pos = OLED_OS_ATOMIC_LOAD(&pqueue->tail);
+  OLED_QueueSlotTypeDef *pslot;
+  for (;;) {
+    pslot = &pqueue->slots[pos & (OLED_QUEUE_LENGTH - 1)];
+    int32_t diff = (int32_t)(OLED_OS_ATOMIC_LOAD(&pslot->sequence) - pos);
+    if (0 == diff) {
+      // CAS失败时pos被更新为最新的写入位置，重新检查
+      if (OLED_OS_ATOMIC_CAS(&pqueue->tail, &pos, pos + 1)) break;
+    } else if (diff < 0) {
+      // 这一格还没有被显示任务取走，队列已满；生产者可能在中断里，计数也用CAS累加
+      uint32_t overflows = OLED_OS_ATOMIC_LOAD(&pqueue->overflows);
+      while (!OLED_OS_ATOMIC_CAS(&pqueue->overflows, &overflows, overflows + 1)) continue;
+      return OLED_BUSY;
+    } else {
+      pos = OLED_OS_ATOMIC_LOAD(&pqueue->tail);  // 其它生产者已经占用了这一格
+    }
+  }
+  pslot->cmd = *pcmd;
+  OLED_OS_ATOMIC_STORE(&pslot->sequence, pos + 1);
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLED_Queue_Fill(OLED_QueueTypeDef *pqueue, uint8_t state)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_FILL, .state = state};
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Draw_Line(OLED_QueueTypeDef *pqueue, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                        uint8_t state)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_LINE, .state = state, .x = x0, .y = y0, .a = x1, .b = y1};
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Draw_Rect(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, int16_t width, int16_t height,
+                                        uint8_t state)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_RECT, .state = state, .x = x, .y = y, .a = width, .b = height};
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Fill_Rect(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, int16_t width, int16_t height,
+                                        uint8_t state)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_FILL_RECT, .state = state, .x = x, .y = y, .a = width, .b = height};
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Draw_Circle(OLED_QueueTypeDef *pqueue, int16_t xc, int16_t yc, int16_t radius,
+                                          uint8_t state)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_CIRCLE, .state = state, .x = xc, .y = yc, .a = radius};
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Fill_Circle(OLED_QueueTypeDef *pqueue, int16_t xc, int16_t yc, int16_t radius,
+                                          uint8_t state)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_FILL_CIRCLE, .state = state, .x = xc, .y = yc, .a = radius};
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Draw_Bitmap(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, uint8_t width,
+                                          uint8_t height, const uint8_t *pbitmap, OLED_RopTypeDef rop)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_BITMAP, .state = rop, .x = x, .y = y, .a = width, .b = height};
+  cmd.param.pbitmap = pbitmap;
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Draw_Text(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                                        const char *pstr, OLED_RopTypeDef rop)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_TEXT, .state = rop, .x = x, .y = y};
+  uint16_t length = 0;
+  while (length < OLED_QUEUE_TEXT_LENGTH - 1 && '\0' != pstr[length]) ++length;
+  // 放不下时不截断在一个字符的中间
+  if ('\0' != pstr[length])
+    while (length > 0 && 0x80 == ((uint8_t)pstr[length] & 0xc0)) --length;
+  memcpy(cmd.param.text.str, pstr, length);
+  cmd.param.text.str[length] = '\0';
+  cmd.param.text.pfont = pfont;
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Call(OLED_QueueTypeDef *pqueue, void (*pfunc)(OLED_HandleTypeDef *, void *), void *parg)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_CALL};
+  cmd.param.call.pfunc = pfunc;
+  cmd.param.call.parg = parg;
+  return OLED_Queue_Post(pqueue, &cmd);
+}
+
+OLED_StatusTypeDef OLED_Queue_Refresh(OLED_QueueTypeDef *pqueue)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_REFRESH};
+  OLED_StatusTypeDef status = OLED_Queue_Post(pqueue, &cmd);
+  if (OLED_OK == status) OLED_OS_Sem_Give(&pqueue->sem);
+  return status;
+}
+
+OLED_StatusTypeDef OLED_Queue_Refresh_ISR(OLED_QueueTypeDef *pqueue)
+{
+  OLED_QueueCmdTypeDef cmd = {.op = OLED_QUEUE_REFRESH};
+  OLED_StatusTypeDef status = OLED_Queue_Post(pqueue, &cmd);
+  if (OLED_OK == status) OLED_OS_Sem_Give_ISR(&pqueue->sem);
+  return status;
+}
+
+/**
+ * 在显示任务中执行一条绘制命令
+ * @param phandle 屏幕实例
+ * @param pcmd 命令
+ */
+static void OLED_Queue_Execute(OLED_HandleTypeDef *phandle, const OLED_QueueCmdTypeDef *pcmd)
+{
+  switch (pcmd->op) {
+    case OLED_QUEUE_FILL: OLEDH_Fill_Buffer(phandle, pcmd->state); break;
+    case OLED_QUEUE_LINE: OLEDH_Draw_Line(phandle, pcmd->x, pcmd->y, pcmd->a, pcmd->b, pcmd->state); break;
+    case OLED_QUEUE_RECT: OLEDH_Draw_Rect(phandle, pcmd->x, pcmd->y, pcmd->a, pcmd->b, pcmd->state); break;
+    case OLED_QUEUE_FILL_RECT: OLEDH_Fill_Rect(phandle, pcmd->x, pcmd->y, pcmd->a, pcmd->b, pcmd->state); break;
+    case OLED_QUEUE_CIRCLE: OLEDH_Draw_Circle(phandle, pcmd->x, pcmd->y, pcmd->a, pcmd->state); break;
+    case OLED_QUEUE_FILL_CIRCLE: OLEDH_Fill_Circle(phandle, pcmd->x, pcmd->y, pcmd->a, pcmd->state); break;
+    case OLED_QUEUE_BITMAP:
+      OLEDH_Draw_Bitmap(phandle, pcmd->x, pcmd->y, pcmd->a, pcmd->b, pcmd->param.pbitmap,
+                        (OLED_RopTypeDef)pcmd->state);
+      break;
+    case OLED_QUEUE_TEXT:
+      OLEDH_Draw_Text(phandle, pcmd->x, pcmd->y, pcmd->param.text.pfont, pcmd->param.text.str,
+                      (OLED_RopTypeDef)pcmd->state);
+      break;
+    case OLED_QUEUE_CALL: pcmd->param.call.pfunc(phandle, pcmd->param.call.parg); break;
+    default: break;
+  }
+}
+
+OLED_StatusTypeDef OLED_Queue_Process(OLED_QueueTypeDef *pqueue, uint32_t timeout)
+{
+  // 上一轮停在一条还没写完的命令上时只短暂等待，让被打断的生产者有机会写完
+  OLED_OS_Sem_Take(&pqueue->sem, pqueue->stalled ? 1 : timeout);
+  uint8_t refresh = 0;
+  pqueue->stalled = 0;
+  for (;;) {
+    OLED_QueueSlotTypeDef *pslot = &pqueue->slots[pqueue->head & (OLED_QUEUE_LENGTH - 1)];
+    if (OLED_OS_ATOMIC_LOAD(&pslot->sequence) != pqueue->head + 1) {
+      pqueue->stalled = pqueue->head != OLED_OS_ATOMIC_LOAD(&pqueue->tail);
+      break;
+    }
+    if (OLED_QUEUE_REFRESH == pslot->cmd.op)
+      refresh = 1;  // 同一轮里的多次刷新请求合并为一次
+    else
+      OLED_Queue_Execute(pqueue->phandle, &pslot->cmd);
+    OLED_OS_ATOMIC_STORE(&pslot->sequence, pqueue->head + OLED_QUEUE_LENGTH);  // 这一格交还给生产者
+    pqueue->head++;
+  }
+  if (!refresh) return OLED_OK;
+#ifdef OLED_USING_DMA_TRANSMIT
+  OLEDH_Wait_Refresh(pqueue->phandle);
+  return OLEDH_Refresh_Async(pqueue->phandle);
+#else
+  return OLEDH_Refresh_GSRAM(pqueue->phandle);
+#endif
+}
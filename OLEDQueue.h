@@ -0,0 +1,150 @@
+/**
+ * @Description 渲染队列，任意任务或中断无锁地投递绘制命令，由唯一的显示任务取出执行并刷新
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDQUEUE_H
+#define OLEDQUEUE_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+#include "OLEDFont.h"
+#include "OLEDOS.h"
+
+#ifndef OLED_QUEUE_LENGTH
+#  define OLED_QUEUE_LENGTH 32  // 队列长度，必须为2的幂
+#endif
+#ifndef OLED_QUEUE_TEXT_LENGTH
+#  define OLED_QUEUE_TEXT_LENGTH 20  // 文字命令保存的UTF-8字节数(含结尾的'\0')，超出部分按字符截断
+#endif
+
+/**
+ * @brief 绘制命令的类型
+ */
+typedef enum {
+  OLED_QUEUE_FILL = 0x00U,         // 填充整个显存，state
+  OLED_QUEUE_LINE = 0x01U,         // 直线(x, y)-(a, b)，state
+  OLED_QUEUE_RECT = 0x02U,         // 矩形边框，宽a高b，state
+  OLED_QUEUE_FILL_RECT = 0x03U,    // 填充矩形，宽a高b，state
+  OLED_QUEUE_CIRCLE = 0x04U,       // 圆，半径a，state
+  OLED_QUEUE_FILL_CIRCLE = 0x05U,  // 填充圆，半径a，state
+  OLED_QUEUE_BITMAP = 0x06U,       // 位图，宽a高b，光栅操作state
+  OLED_QUEUE_TEXT = 0x07U,         // UTF-8文字，光栅操作state
+  OLED_QUEUE_CALL = 0x08U,         // 在显示任务中调用用户函数
+  OLED_QUEUE_REFRESH = 0x09U,      // 本帧绘制结束，请求刷新
+} OLED_QueueOpTypeDef;
+
+/**
+ * @brief 一条绘制命令
+ * @note 位图、字库和用户函数的参数只保存指针，执行前必须保持有效；文字内容拷贝到命令里
+ */
+typedef struct {
+  uint8_t op;     // OLED_QueueOpTypeDef
+  uint8_t state;  // 点的状态或光栅操作
+  int16_t x;      // 横坐标
+  int16_t y;      // 纵坐标
+  int16_t a;      // 终点横坐标/宽度/半径
+  int16_t b;      // 终点纵坐标/高度
+  union {
+    const uint8_t *pbitmap;  // 位图数据
+    struct {
+      const OLED_FontTypeDef *pfont;      // 字库
+      char str[OLED_QUEUE_TEXT_LENGTH];  // 文字
+    } text;
+    struct {
+      void (*pfunc)(OLED_HandleTypeDef *phandle, void *parg);  // 用户函数
+      void *parg;                                              // 用户参数
+    } call;
+  } param;
+} OLED_QueueCmdTypeDef;
+
+/**
+ * @brief 队列中的一格，sequence标记这一格当前可以被写入还是读出
+ */
+typedef struct {
+  volatile uint32_t sequence;  // 等于写入位置时可写，等于写入位置 + 1时可读
+  OLED_QueueCmdTypeDef cmd;    // 命令
+} OLED_QueueSlotTypeDef;
+
+/**
+ * @brief 渲染队列，多个生产者、一个消费者(显示任务)
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;                    // 显示任务独占的屏幕实例
+  OLED_QueueSlotTypeDef slots[OLED_QUEUE_LENGTH];  // 环形缓冲
+  volatile uint32_t tail;                         // 下一个写入位置，生产者之间用CAS竞争
+  uint32_t head;                                  // 下一个读出位置，只有显示任务访问
+  OLED_OSSemTypeDef sem;                          // 有刷新请求时释放，唤醒显示任务
+  volatile uint32_t overflows;                    // 队列已满而丢弃的命令数
+  uint8_t stalled;                                // 上一轮停在一条还没有写完的命令上
+} OLED_QueueTypeDef;
+
+/**
+ * 初始化渲染队列
+ * @param pqueue 队列
+ * @param phandle 屏幕实例，初始化后只能由显示任务访问
+ * @return 信号量创建失败时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Queue_Init(OLED_QueueTypeDef *pqueue, OLED_HandleTypeDef *phandle);
+
+/**
+ * 投递一条命令，不会阻塞，可以在中断里调用
+ * @note OLED_QUEUE_REFRESH命令需要唤醒显示任务，请使用OLED_Queue_Refresh/OLED_Queue_Refresh_ISR
+ * @param pqueue 队列
+ * @param pcmd 命令
+ * @return 队列已满时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Queue_Post(OLED_QueueTypeDef *pqueue, const OLED_QueueCmdTypeDef *pcmd);
+
+/**
+ * 投递常用命令，参数含义与OLEDGraphics.h、OLEDFont.h中的同名函数相同
+ * @return 队列已满时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Queue_Fill(OLED_QueueTypeDef *pqueue, uint8_t state);
+OLED_StatusTypeDef OLED_Queue_Draw_Line(OLED_QueueTypeDef *pqueue, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                        uint8_t state);
+OLED_StatusTypeDef OLED_Queue_Draw_Rect(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, int16_t width, int16_t height,
+                                        uint8_t state);
+OLED_StatusTypeDef OLED_Queue_Fill_Rect(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, int16_t width, int16_t height,
+                                        uint8_t state);
+OLED_StatusTypeDef OLED_Queue_Draw_Circle(OLED_QueueTypeDef *pqueue, int16_t xc, int16_t yc, int16_t radius,
+                                          uint8_t state);
+OLED_StatusTypeDef OLED_Queue_Fill_Circle(OLED_QueueTypeDef *pqueue, int16_t xc, int16_t yc, int16_t radius,
+                                          uint8_t state);
+OLED_StatusTypeDef OLED_Queue_Draw_Bitmap(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, uint8_t width,
+                                          uint8_t height, const uint8_t *pbitmap, OLED_RopTypeDef rop);
+OLED_StatusTypeDef OLED_Queue_Draw_Text(OLED_QueueTypeDef *pqueue, int16_t x, int16_t y, const OLED_FontTypeDef *pfont,
+                                        const char *pstr, OLED_RopTypeDef rop);
+OLED_StatusTypeDef OLED_Queue_Call(OLED_QueueTypeDef *pqueue, void (*pfunc)(OLED_HandleTypeDef *, void *), void *parg);
+
+/**
+ * 结束一帧的绘制并唤醒显示任务，只能在任务中调用
+ * @param pqueue 队列
+ * @return 队列已满时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Queue_Refresh(OLED_QueueTypeDef *pqueue);
+
+/**
+ * 在中断里结束一帧的绘制并唤醒显示任务
+ * @param pqueue 队列
+ * @return 队列已满时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Queue_Refresh_ISR(OLED_QueueTypeDef *pqueue);
+
+/**
+ * 显示任务的一次循环: 等待刷新请求，取出队列中所有的命令执行，其中有刷新请求时只刷新一次
+ * @note 只能由一个任务调用，屏幕实例、显存与总线都归这个任务所有
+ * @note 定义OLED_USING_DMA_TRANSMIT时等待上一次异步刷新完成后再发起新的异步刷新
+ * @param pqueue 队列
+ * @param timeout 等待刷新请求的最长时间(毫秒)，超时后仍然执行已经入队的命令
+ * @return 刷新的结果，没有刷新时返回OLED_OK
+ */
+OLED_StatusTypeDef OLED_Queue_Process(OLED_QueueTypeDef *pqueue, uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDQUEUE_H
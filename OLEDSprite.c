@@ -0,0 +1,277 @@
+/**
+ * @Description 精灵绘制，支持透明遮罩、翻转，以及预先移位好8种纵向偏移的缓存
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDSprite.h"
+#include "OLEDGraphics.h"
+
+/**
+ * 翻转一个字节的位序
+ */
+static inline uint8_t OLED_Reverse_Bits(uint8_t value)
+{
+  value = (uint8_t)((value & 0xf0) >> 4 | (value & 0x0f) << 4);
+  value = (uint8_t)((value & 0xcc) >> 2 | (value & 0x33) << 2);
+  return (uint8_t)((value & 0xaa) >> 1 | (value & 0x55) << 1);
+}
+
+/**
+ * 读取按页存储的数据中某一列从row开始的8个点，超出[0, pages)页的部分为0
+ * @param pplane 数据，为NULL时所有页都是0xff
+ * @param width 宽度
+ * @param pages 页数
+ * @param column 列号
+ * @param row 起始行，可以为负
+ * @return 8个点，低位在上
+ */
+static uint8_t OLED_Read_Column(const uint8_t *pplane, uint8_t width, uint8_t pages, uint8_t column, int16_t row)
+{
+  uint8_t shift = row & 7;
+  int16_t page = (row - shift) / 8;
+  uint8_t low = 0, high = 0;
+  if (page >= 0 && page < pages) low = NULL == pplane ? 0xff : pplane[page * width + column];
+  if (0 != shift && page + 1 >= 0 && page + 1 < pages)
+    high = NULL == pplane ? 0xff : pplane[(page + 1) * width + column];
+  return (uint8_t)(low >> shift | high << (8 - shift));
+}
+
+/**
+ * 读取精灵翻转后第page页第column列的8个点，超出精灵高度的点为0
+ * @param psprite 精灵
+ * @param pplane 点阵或遮罩，为NULL时表示整个矩形
+ * @param column 翻转后的列号
+ * @param page 翻转后的页号
+ * @param flip 翻转方式
+ * @return 8个点，低位在上
+ */
+static uint8_t OLED_Sprite_Fetch(const OLED_SpriteTypeDef *psprite, const uint8_t *pplane, uint8_t column,
+                                 uint8_t page, uint8_t flip)
+{
+  uint8_t pages = (psprite->height + 7) / 8;
+  if (flip & OLED_SPRITE_FLIP_H) column = psprite->width - 1 - column;
+  if (flip & OLED_SPRITE_FLIP_V) {
+    // 翻转后的第8 * page + i行为原来的第height - 1 - 8 * page - i行，一次读出8行再翻转位序
+    int16_t row = psprite->height - 8 - 8 * page;
+    return OLED_Reverse_Bits(OLED_Read_Column(pplane, psprite->width, pages, column, row));
+  }
+  uint8_t value = OLED_Read_Column(pplane, psprite->width, pages, column, 8 * page);
+  if (page == pages - 1 && (psprite->height & 7)) value &= 0xff >> (8 - (psprite->height & 7));
+  return value;
+}
+
+#if OLED_SWAP_AXES
+/**
+ * 读取精灵旋转到显存方向后第page页第column列的8个点，只在建立预移位缓存时使用
+ * @param psprite 精灵
+ * @param pplane 点阵或遮罩，为NULL时表示整个矩形
+ * @param column 显存方向的列号
+ * @param page 显存方向的页号
+ * @param flip 翻转方式
+ * @return 8个点，低位在上
+ */
+static uint8_t OLED_Sprite_Fetch_Rotated(const OLED_SpriteTypeDef *psprite, const uint8_t *pplane, uint8_t column,
+                                         uint8_t page, uint8_t flip)
+{
+  uint8_t value = 0;
+  for (uint8_t i = 0; i < 8 && 8 * page + i < psprite->width; ++i) {
+#  if OLED_ROTATION == 90
+    uint8_t sprite_x = 8 * page + i, sprite_y = psprite->height - 1 - column;
+#  else
+    uint8_t sprite_x = psprite->width - 1 - (8 * page + i), sprite_y = column;
+#  endif
+    value |= (uint8_t)((OLED_Sprite_Fetch(psprite, pplane, sprite_x, sprite_y / 8, flip) >> (sprite_y & 7) & 1) << i);
+  }
+  return value;
+}
+#  define OLED_SPRITE_CACHE_FETCH OLED_Sprite_Fetch_Rotated  // 缓存按显存方向存储，绘制时不再旋转
+#else
+#  define OLED_SPRITE_CACHE_FETCH OLED_Sprite_Fetch
+#endif
+
+/**
+ * 把一个字节按光栅操作写入显存
+ * @param pdst 目标字节
+ * @param bits 点阵，已经和遮罩相与
+ * @param mask 遮罩
+ * @param rop 光栅操作
+ */
+static inline void OLED_Sprite_Apply(uint8_t *pdst, uint8_t bits, uint8_t mask, OLED_RopTypeDef rop)
+{
+  switch (rop) {
+    case OLED_ROP_OR: *pdst |= bits; break;
+    case OLED_ROP_AND_NOT: *pdst &= ~bits; break;
+    case OLED_ROP_XOR: *pdst ^= bits; break;
+    default: *pdst = (*pdst & ~mask) | bits; break;
+  }
+}
+
+/**
+ * 裁剪精灵的绘制范围，并标记改动区域
+ * @return 完全在屏幕外时返回OLED_OUT_RANGE
+ */
+static OLED_StatusTypeDef OLED_Sprite_Clip(OLED_HandleTypeDef *phandle, int16_t x, int16_t y, uint8_t width,
+                                           uint8_t height, int16_t *px_start, int16_t *px_end)
+{
+  if (0 == width || 0 == height) return OLED_OUT_RANGE;
+  *px_start = x < 0 ? 0 : x;
+  *px_end = x + width - 1 >= phandle->width ? phandle->width - 1 : x + width - 1;
+  if (*px_start > *px_end || y >= phandle->height || y + height <= 0) return OLED_OUT_RANGE;
+  OLEDH_MARK_DIRTY(phandle, *px_start, *px_end, y < 0 ? 0 : y / 8, (y + height - 1) / 8);
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLEDH_Draw_Sprite(OLED_HandleTypeDef *phandle, int16_t x, int16_t y,
+                                     const OLED_SpriteTypeDef *psprite, uint8_t flip, OLED_RopTypeDef rop)
+{
+  if (NULL == psprite->pmask && 0 == flip)
+    return OLEDH_Draw_Bitmap(phandle, x, y, psprite->width, psprite->height, psprite->pbitmap, rop);
+#if OLED_SWAP_AXES
+  // 旋转90/270度时精灵的一列落在显存某一页中的一行上，每列换算一次坐标，列内只移动显存指针
+  if (0 == psprite->width || 0 == psprite->height) return OLED_OUT_RANGE;
+  int16_t column_start = x < 0 ? -x : 0, row_start = y < 0 ? -y : 0;
+  int16_t column_end = psprite->width - 1, row_end = psprite->height - 1;
+  if (x + column_end >= OLEDH_WIDTH(phandle)) column_end = OLEDH_WIDTH(phandle) - 1 - x;
+  if (y + row_end >= OLEDH_HEIGHT(phandle)) row_end = OLEDH_HEIGHT(phandle) - 1 - y;
+  if (column_start > column_end || row_start > row_end) return OLED_OUT_RANGE;
+
+  for (int16_t column = column_start; column <= column_end; ++column) {
+    int16_t phys_x = OLEDH_PHYS_X(phandle, x + column, y + row_start);
+    int16_t phys_y = OLEDH_PHYS_Y(phandle, x + column, y + row_start);
+    uint8_t *pdst = &phandle->pbuffer[(phys_y >> 3) * phandle->width + phys_x];
+    uint8_t bit = 1 << (phys_y & 7), mask = 0, bits = 0;
+    for (int16_t row = row_start; row <= row_end; ++row, pdst += OLED_PHYS_ROW_STEP) {
+      if (0 == (row & 7) || row == row_start) {
+        mask = OLED_Sprite_Fetch(psprite, psprite->pmask, column, row >> 3, flip) >> (row & 7);
+        bits = OLED_Sprite_Fetch(psprite, psprite->pbitmap, column, row >> 3, flip) >> (row & 7) & mask;
+      }
+      if (mask & 1) OLED_Sprite_Apply(pdst, bits & 1 ? bit : 0, bit, rop);
+      mask >>= 1;
+      bits >>= 1;
+    }
+  }
+
+  int16_t dirty_x = x + column_start, dirty_y = y + row_start;
+  int16_t dirty_width = column_end - column_start + 1, dirty_height = row_end - row_start + 1;
+  OLEDH_PHYS_RECT(phandle, dirty_x, dirty_y, dirty_width, dirty_height);
+  OLEDH_MARK_DIRTY(phandle, dirty_x, dirty_x + dirty_width - 1, dirty_y / 8, (dirty_y + dirty_height - 1) / 8);
+  return OLED_OK;
+#else
+  int16_t x_start, x_end;
+  if (OLED_OK != OLED_Sprite_Clip(phandle, x, y, psprite->width, psprite->height, &x_start, &x_end))
+    return OLED_OUT_RANGE;
+
+  uint8_t shift = y & 7;
+  int16_t page_base = (y - shift) / 8;  // 负数时向下取整
+  uint8_t src_pages = (psprite->height + 7) / 8;
+  for (uint8_t src_page = 0; src_page < src_pages; ++src_page) {
+    int16_t page = page_base + src_page;
+    uint8_t *plow = page >= 0 && page < phandle->pages ? &phandle->pbuffer[page * phandle->width] : NULL;
+    uint8_t *phigh = page + 1 >= 0 && page + 1 < phandle->pages ? &phandle->pbuffer[(page + 1) * phandle->width] : NULL;
+    for (int16_t column = x_start; column <= x_end; ++column) {
+      uint8_t mask = OLED_Sprite_Fetch(psprite, psprite->pmask, column - x, src_page, flip);
+      if (0 == mask) continue;
+      uint8_t bits = OLED_Sprite_Fetch(psprite, psprite->pbitmap, column - x, src_page, flip) & mask;
+      if (NULL != plow) OLED_Sprite_Apply(&plow[column], (uint8_t)(bits << shift), (uint8_t)(mask << shift), rop);
+      if (NULL != phigh && 0 != shift)
+        OLED_Sprite_Apply(&phigh[column], bits >> (8 - shift), mask >> (8 - shift), rop);
+    }
+  }
+  return OLED_OK;
+#endif
+}
+
+OLED_StatusTypeDef OLED_Draw_Sprite(int16_t x, int16_t y, const OLED_SpriteTypeDef *psprite, uint8_t flip,
+                                    OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_Sprite(&g_oled_handle, x, y, psprite, flip, rop);
+}
+
+OLED_StatusTypeDef OLED_Sprite_Cache_Init(OLED_SpriteCacheTypeDef *pcache, const OLED_SpriteTypeDef *psprite,
+                                          uint8_t flip, uint8_t *pdata, uint32_t size)
+{
+  if (size < OLED_SPRITE_CACHE_SIZE(psprite->width, psprite->height)) return OLED_ERROR;
+  pcache->pdata = pdata;
+#if OLED_SWAP_AXES
+  pcache->width = psprite->height;
+  pcache->height = psprite->width;
+#else
+  pcache->width = psprite->width;
+  pcache->height = psprite->height;
+#endif
+  pcache->pages = (pcache->height + 7) / 8;
+  uint16_t plane = (pcache->pages + 1) * pcache->width;
+  for (uint8_t shift = 0; shift < 8; ++shift) {
+    uint8_t *pbits = pdata + shift * 2 * plane, *pmask = pbits + plane;
+    for (uint8_t page = 0; page <= pcache->pages; ++page) {
+      for (uint8_t column = 0; column < pcache->width; ++column) {
+        // 移位后的第page页由原来第page页的低位部分和第page - 1页的高位部分拼成
+        uint8_t mask = 0, bits = 0;
+        if (page < pcache->pages) {
+          uint8_t m = OLED_SPRITE_CACHE_FETCH(psprite, psprite->pmask, column, page, flip);
+          mask = (uint8_t)(m << shift);
+          bits = (uint8_t)((OLED_SPRITE_CACHE_FETCH(psprite, psprite->pbitmap, column, page, flip) & m) << shift);
+        }
+        if (page > 0 && 0 != shift) {
+          uint8_t m = OLED_SPRITE_CACHE_FETCH(psprite, psprite->pmask, column, page - 1, flip);
+          mask |= m >> (8 - shift);
+          bits |= (OLED_SPRITE_CACHE_FETCH(psprite, psprite->pbitmap, column, page - 1, flip) & m) >> (8 - shift);
+        }
+        pbits[page * pcache->width + column] = bits;
+        pmask[page * pcache->width + column] = mask;
+      }
+    }
+  }
+  return OLED_OK;
+}
+
+/**
+ * 预移位数据的一页写入显存，光栅操作在循环外选择
+ */
+#define OLED_SPRITE_LOOP(OP) \
+  for (uint16_t i = 0; i < count; ++i) OP(pdst[i], pbits[i], pmask[i])
+#define OLED_SPRITE_COPY_OP(dst, bits, mask) dst = (dst & ~(mask)) | (bits)
+#define OLED_SPRITE_OR_OP(dst, bits, mask) dst |= (bits)
+#define OLED_SPRITE_AND_NOT_OP(dst, bits, mask) dst &= ~(bits)
+#define OLED_SPRITE_XOR_OP(dst, bits, mask) dst ^= (bits)
+
+OLED_StatusTypeDef OLEDH_Draw_Sprite_Cached(OLED_HandleTypeDef *phandle, int16_t x, int16_t y,
+                                            const OLED_SpriteCacheTypeDef *pcache, OLED_RopTypeDef rop)
+{
+#if OLED_SWAP_AXES
+  // 缓存已经按显存方向存储，只需要把左上角换算成显存坐标
+  int16_t width = pcache->height, height = pcache->width;
+  OLEDH_PHYS_RECT(phandle, x, y, width, height);
+#endif
+  int16_t x_start, x_end;
+  if (OLED_OK != OLED_Sprite_Clip(phandle, x, y, pcache->width, pcache->height, &x_start, &x_end))
+    return OLED_OUT_RANGE;
+
+  uint8_t shift = y & 7;
+  int16_t page_base = (y - shift) / 8;
+  uint16_t plane = (pcache->pages + 1) * pcache->width;
+  uint16_t count = x_end - x_start + 1;
+  const uint8_t *pvariant = pcache->pdata + shift * 2 * plane + (x_start - x);
+  uint8_t last = 0 == shift ? pcache->pages - 1 : pcache->pages;  // 不偏移时多出的一页全为0
+  for (uint8_t src_page = 0; src_page <= last; ++src_page) {
+    int16_t page = page_base + src_page;
+    if (page < 0) continue;
+    if (page >= phandle->pages) break;
+    uint8_t *pdst = &phandle->pbuffer[page * phandle->width + x_start];
+    const uint8_t *pbits = pvariant + src_page * pcache->width, *pmask = pbits + plane;
+    switch (rop) {
+      case OLED_ROP_OR: OLED_SPRITE_LOOP(OLED_SPRITE_OR_OP); break;
+      case OLED_ROP_AND_NOT: OLED_SPRITE_LOOP(OLED_SPRITE_AND_NOT_OP); break;
+      case OLED_ROP_XOR: OLED_SPRITE_LOOP(OLED_SPRITE_XOR_OP); break;
+      default: OLED_SPRITE_LOOP(OLED_SPRITE_COPY_OP); break;
+    }
+  }
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLED_Draw_Sprite_Cached(int16_t x, int16_t y, const OLED_SpriteCacheTypeDef *pcache,
+                                           OLED_RopTypeDef rop)
+{
+  return OLEDH_Draw_Sprite_Cached(&g_oled_handle, x, y, pcache, rop);
+}
@@ -0,0 +1,99 @@
+/**
+ * @Description 精灵绘制，支持透明遮罩、翻转，以及预先移位好8种纵向偏移的缓存
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDSPRITE_H
+#define OLEDSPRITE_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+#define OLED_SPRITE_FLIP_H 0x01U  // 左右翻转
+#define OLED_SPRITE_FLIP_V 0x02U  // 上下翻转
+
+/**
+ * 预移位缓存需要的字节数: 8种偏移，每种(页数 + 1)页的点阵和遮罩
+ * @note OLED_ROTATION为90/270时缓存按显存方向存储，宽高互换
+ */
+#if OLED_SWAP_AXES
+#  define OLED_SPRITE_CACHE_SIZE(width, height) (16U * (((width) + 7U) / 8U + 1U) * (height))
+#else
+#  define OLED_SPRITE_CACHE_SIZE(width, height) (16U * (((height) + 7U) / 8U + 1U) * (width))
+#endif
+
+/**
+ * @brief 精灵
+ * @note 点阵与遮罩的格式与OLED_Draw_Bitmap相同: 一页width个字节，共(height + 7) / 8页
+ */
+typedef struct {
+  const uint8_t *pbitmap;  // 点阵数据
+  const uint8_t *pmask;    // 遮罩，为1的点属于精灵，为0的点透明；为NULL时整个矩形都属于精灵
+  uint8_t width;           // 宽度
+  uint8_t height;          // 高度
+} OLED_SpriteTypeDef;
+
+/**
+ * @brief 精灵的预移位缓存
+ * @note 第shift种偏移的数据从pdata + shift * 2 * (pages + 1) * width开始，先是点阵再是遮罩，点阵已经和遮罩相与
+ * @note 绘制时纵坐标的页内偏移直接选择对应的一份，每列每页只需要一次与、或
+ */
+typedef struct {
+  uint8_t *pdata;  // 用户提供的缓存，至少OLED_SPRITE_CACHE_SIZE(width, height)字节
+  uint8_t width;   // 显存方向的宽度，OLED_ROTATION为90/270时是精灵的高度
+  uint8_t height;  // 显存方向的高度
+  uint8_t pages;   // 精灵本身的页数，每种偏移占pages + 1页
+} OLED_SpriteCacheTypeDef;
+
+/**
+ * 在任意像素位置绘制精灵
+ * @note 没有遮罩、不翻转时与OLED_Draw_Bitmap相同
+ * @note OLED_ROP_COPY只覆盖遮罩为1的点，其余光栅操作只作用于遮罩为1且点阵为1的点
+ * @param x 左上角横坐标，可以为负
+ * @param y 左上角纵坐标，可以为负
+ * @param psprite 精灵
+ * @param flip OLED_SPRITE_FLIP_H、OLED_SPRITE_FLIP_V的组合
+ * @param rop 光栅操作
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_Sprite(int16_t x, int16_t y, const OLED_SpriteTypeDef *psprite, uint8_t flip,
+                                    OLED_RopTypeDef rop);
+
+/**
+ * 生成精灵的预移位缓存，翻转在这里一次完成
+ * @param pcache 缓存
+ * @param psprite 精灵
+ * @param flip OLED_SPRITE_FLIP_H、OLED_SPRITE_FLIP_V的组合
+ * @param pdata 缓存数据区
+ * @param size 缓存数据区的字节数
+ * @return 数据区小于OLED_SPRITE_CACHE_SIZE时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Sprite_Cache_Init(OLED_SpriteCacheTypeDef *pcache, const OLED_SpriteTypeDef *psprite,
+                                          uint8_t flip, uint8_t *pdata, uint32_t size);
+
+/**
+ * 使用预移位缓存绘制精灵，结果与OLED_Draw_Sprite相同
+ * @param x 左上角横坐标，可以为负
+ * @param y 左上角纵坐标，可以为负
+ * @param pcache 缓存
+ * @param rop 光栅操作
+ * @return OLED Status
+ */
+OLED_StatusTypeDef OLED_Draw_Sprite_Cached(int16_t x, int16_t y, const OLED_SpriteCacheTypeDef *pcache,
+                                           OLED_RopTypeDef rop);
+
+/**
+ * @brief 多实例接口，第一个参数为屏幕实例，其余参数与返回值同上面不带句柄的同名函数
+ */
+OLED_StatusTypeDef OLEDH_Draw_Sprite(OLED_HandleTypeDef *phandle, int16_t x, int16_t y,
+                                     const OLED_SpriteTypeDef *psprite, uint8_t flip, OLED_RopTypeDef rop);
+OLED_StatusTypeDef OLEDH_Draw_Sprite_Cached(OLED_HandleTypeDef *phandle, int16_t x, int16_t y,
+                                            const OLED_SpriteCacheTypeDef *pcache, OLED_RopTypeDef rop);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDSPRITE_H
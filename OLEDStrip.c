@@ -0,0 +1,98 @@
+/**
+ * @Description 分条渲染，不使用整帧显存，把画面按几页一条渲染到很小的条带缓存中，渲染完一条就发送一条
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDStrip.h"
+
+OLED_StatusTypeDef OLED_Strip_Init(OLED_StripTypeDef *pstrip, OLED_HandleTypeDef *phandle, uint8_t *pbuffer,
+                                   uint8_t *pbuffer2, uint8_t pages, OLED_StripDrawTypeDef draw)
+{
+  memset(pstrip, 0, sizeof(OLED_StripTypeDef));
+  if (NULL == pbuffer || NULL == draw || 0 == pages || pages > OLED_MAX_PAGE_SIZE) return OLED_ERROR;
+  pstrip->phandle = NULL != phandle ? phandle : &g_oled_handle;
+  pstrip->pbuffers[0] = pbuffer;
+  pstrip->pbuffers[1] = pbuffer2;
+  pstrip->pages = pages;
+  pstrip->draw = draw;
+  return OLED_OK;
+}
+
+/**
+ * 清空条带缓存并调用绘制回调画出[page, last]页
+ * @param pstrip 分条渲染器
+ * @param pbuffer 条带缓存
+ * @param page 条带的起始页
+ * @param last 条带的结束页
+ */
+static void OLED_Strip_Draw_Band(OLED_StripTypeDef *pstrip, uint8_t *pbuffer, uint8_t page, uint8_t last)
+{
+  const OLED_HandleTypeDef *phandle = pstrip->phandle;
+  OLED_HandleTypeDef band;
+  uint8_t row = page * 8;
+  memset(&band, 0, sizeof(OLED_HandleTypeDef));
+  band.pbuffer = pbuffer;
+  band.width = phandle->width;
+  band.pages = last - page + 1;
+  // 高度不是8的倍数时最后一条只有部分行可见
+  band.height = phandle->height - row < band.pages * 8 ? phandle->height - row : band.pages * 8;
+  memset(pbuffer, 0, OLED_STRIP_BUFFER_SIZE(band.width, band.pages));
+  // 条带是显存的第row行起的band.height行，换算成它在绘图坐标系中的位置
+#if OLED_ROTATION == 90
+  pstrip->draw(pstrip, &band, row, 0);
+#elif OLED_ROTATION == 270
+  pstrip->draw(pstrip, &band, phandle->height - row - band.height, 0);
+#else
+  pstrip->draw(pstrip, &band, 0, row);
+#endif
+  pstrip->stats.strips++;
+}
+
+/**
+ * 等待上一个条带发送完成，阻塞发送时直接返回
+ * @param phandle 屏幕实例
+ * @param sent 这一帧已经发出过条带，没有时不检查之前刷新留下的出错状态
+ * @return 上一个条带发送出错时返回OLED_ERROR
+ */
+static OLED_StatusTypeDef OLED_Strip_Wait(OLED_HandleTypeDef *phandle, uint8_t sent)
+{
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (sent) return OLEDH_Wait_Refresh(phandle);
+#else
+  (void)phandle;
+  (void)sent;
+#endif
+  return OLED_OK;
+}
+
+OLED_StatusTypeDef OLED_Strip_Render(OLED_StripTypeDef *pstrip)
+{
+  OLED_HandleTypeDef *phandle = pstrip->phandle;
+  OLED_StatusTypeDef status = OLED_OK;
+  uint8_t index = 0;
+#ifdef OLED_USING_DMA_TRANSMIT
+  if (OLED_REFRESH_BUSY == phandle->refresh_state) return OLED_BUSY;
+#endif
+  for (uint8_t page = 0; OLED_OK == status && page < phandle->pages; page += pstrip->pages) {
+    uint8_t last = phandle->pages - page > pstrip->pages ? page + pstrip->pages - 1 : phandle->pages - 1;
+    uint8_t *pbuffer = pstrip->pbuffers[index];
+#ifdef OLED_USING_DMA_TRANSMIT
+    if (OLED_REFRESH_BUSY == phandle->refresh_state) {
+      if (NULL == pstrip->pbuffers[1])
+        status = OLEDH_Wait_Refresh(phandle);  // 只有一块缓存时要等它发完才能重画
+      else
+        pstrip->stats.overlaps++;  // 另一块缓存正在发送，这一块已经空闲
+    }
+    if (OLED_OK != status) break;
+#endif
+    OLED_Strip_Draw_Band(pstrip, pbuffer, page, last);
+    status = OLED_Strip_Wait(phandle, 0 != page);
+    if (OLED_OK == status) status = OLEDH_Write_Pages(phandle, pbuffer, page, last);
+    if (NULL != pstrip->pbuffers[1]) index ^= 1;
+  }
+  OLED_StatusTypeDef last_status = OLED_Strip_Wait(phandle, 1);
+  if (OLED_OK == status) status = last_status;
+  pstrip->stats.frames++;
+  return status;
+}
@@ -0,0 +1,81 @@
+/**
+ * @Description 分条渲染，不使用整帧显存，把画面按几页一条渲染到很小的条带缓存中，渲染完一条就发送一条
+ * @note 每一条都要重新调用一次绘制回调画出整个画面，绘图函数把超出条带的部分裁剪掉，用CPU时间换取RAM
+ * @note 提供两块条带缓存且定义OLED_USING_DMA_TRANSMIT时，渲染下一条与发送上一条同时进行
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDSTRIP_H
+#define OLEDSTRIP_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+
+/**
+ * @brief 一块条带缓存需要的字节数
+ */
+#define OLED_STRIP_BUFFER_SIZE(width, pages) ((uint16_t)(width) * (pages))
+
+typedef struct OLED_StripTypeDef OLED_StripTypeDef;
+
+/**
+ * 在一个条带上绘制整个画面
+ * @note 条带的实例只用于绘制，屏幕绘图坐标(sx, sy)在条带中为(sx - x, sy - y)，超出条带的部分被裁剪
+ * @note OLED_ROTATION为90/270时条带在绘图坐标系中是竖条，x不为0，y为0
+ * @param pstrip 分条渲染器
+ * @param pband 条带的实例，已经清空
+ * @param x 条带左上角在绘图坐标系中的横坐标
+ * @param y 条带左上角在绘图坐标系中的纵坐标
+ */
+typedef void (*OLED_StripDrawTypeDef)(OLED_StripTypeDef *pstrip, OLED_HandleTypeDef *pband, int16_t x, int16_t y);
+
+/**
+ * @brief 分条渲染的统计
+ */
+typedef struct {
+  uint32_t frames;    // 渲染的帧数
+  uint32_t strips;    // 渲染的条带数
+  uint32_t overlaps;  // 上一条还在发送时就开始渲染的条带数
+} OLED_StripStatsTypeDef;
+
+/**
+ * @brief 分条渲染器，由用户分配
+ */
+struct OLED_StripTypeDef {
+  OLED_HandleTypeDef *phandle;   // 显示的屏幕实例，可以没有显存
+  uint8_t *pbuffers[2];          // 条带缓存，第二块为NULL时不流水
+  uint8_t pages;                 // 每个条带的页数
+  OLED_StripDrawTypeDef draw;    // 绘制回调
+  void *puser;                   // 用户数据，初始化之后填写，驱动不使用
+  OLED_StripStatsTypeDef stats;  // 统计
+};
+
+/**
+ * 初始化分条渲染器
+ * @param pstrip 分条渲染器
+ * @param phandle 屏幕实例，为NULL时使用默认实例
+ * @param pbuffer 条带缓存，大小为OLED_STRIP_BUFFER_SIZE(屏幕宽度, pages)
+ * @param pbuffer2 第二块条带缓存，大小相同，可为NULL；异步发送时提供后渲染与发送交替进行
+ * @param pages 每个条带的页数，1 ~ OLED_MAX_PAGE_SIZE
+ * @param draw 绘制回调
+ * @return 参数无效时返回OLED_ERROR
+ */
+OLED_StatusTypeDef OLED_Strip_Init(OLED_StripTypeDef *pstrip, OLED_HandleTypeDef *phandle, uint8_t *pbuffer,
+                                   uint8_t *pbuffer2, uint8_t pages, OLED_StripDrawTypeDef draw);
+
+/**
+ * 渲染并发送一整帧，从第0页开始每条清空条带缓存、调用绘制回调，再用OLEDH_Write_Pages发送
+ * @note 定义OLED_USING_DMA_TRANSMIT时发送在中断里进行，有两块缓存时画下一条的同时发送上一条，返回前等待最后一条发完
+ * @note 实例有显存时，发送后屏幕与显存不一致，之后再用OLED_Refresh_GSRAM刷新时整屏发送
+ * @param pstrip 分条渲染器
+ * @return 发送出错时停止并返回错误，屏幕正在异步刷新时返回OLED_BUSY
+ */
+OLED_StatusTypeDef OLED_Strip_Render(OLED_StripTypeDef *pstrip);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDSTRIP_H
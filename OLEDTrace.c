@@ -0,0 +1,129 @@
+/**
+ * @Description 性能统计，定义OLED_USING_TRACE后记录每类操作的次数、耗时、传输字节数、错误数与刷新延迟分布
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#if defined(OLED_USING_TRACE) && (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)
+#  define _POSIX_C_SOURCE 199309L  // -std=c99/c11下不声明clock_gettime
+#endif
+#include "OLEDTrace.h"
+
+#ifdef OLED_USING_TRACE
+#  include <stdarg.h>
+#  include <stdio.h>
+#  include <string.h>
+
+static const char *const s_oled_trace_names[OLED_TRACE_OP_COUNT] = {
+    "refresh", "refresh_async", "write_cmd", "cmd_transfer", "data_transfer", "list_transfer",
+};
+
+void OLED_Trace_Init(OLED_TraceTypeDef *ptrace, uint32_t (*pclock)(void))
+{
+  memset(ptrace, 0, sizeof(OLED_TraceTypeDef));
+  ptrace->pclock = pclock;
+}
+
+void OLED_Trace_Reset(OLED_TraceTypeDef *ptrace) { memset(&ptrace->stats, 0, sizeof(OLED_TraceStatsTypeDef)); }
+
+void OLED_Trace_Get_Stats(const OLED_TraceTypeDef *ptrace, OLED_TraceStatsTypeDef *pstats) { *pstats = ptrace->stats; }
+
+void OLED_Trace_Begin(OLED_TraceTypeDef *ptrace, OLED_TraceOpTypeDef op)
+{
+  ptrace->start[op] = NULL != ptrace->pclock ? ptrace->pclock() : 0;
+}
+
+void OLED_Trace_End(OLED_TraceTypeDef *ptrace, OLED_TraceOpTypeDef op, uint8_t failed)
+{
+  uint32_t elapsed = NULL != ptrace->pclock ? ptrace->pclock() - ptrace->start[op] : 0;
+  OLED_TraceOpStatsTypeDef *pop = &ptrace->stats.ops[op];
+  pop->calls++;
+  if (failed) pop->errors++;
+  pop->total += elapsed;
+  if (elapsed > pop->max) pop->max = elapsed;
+  if (OLED_TRACE_REFRESH != op && OLED_TRACE_REFRESH_ASYNC != op) return;
+  uint8_t bucket = 0;
+  while (elapsed > 1 && bucket < OLED_TRACE_HIST_BUCKETS - 1) {
+    elapsed >>= 1;
+    ++bucket;
+  }
+  ptrace->stats.histogram[bucket]++;
+}
+
+void OLED_Trace_Bytes(OLED_TraceTypeDef *ptrace, uint8_t mode, uint16_t size)
+{
+  if (mode)
+    ptrace->stats.data_bytes += size;
+  else
+    ptrace->stats.cmd_bytes += size;
+}
+
+/**
+ * 向缓存末尾追加格式化的文本，放不下的部分截断
+ * @param pbuf 缓存
+ * @param size 缓存大小
+ * @param plength 已经写入的字符数，追加后更新
+ * @param pformat 格式
+ */
+static void OLED_Trace_Append(char *pbuf, uint16_t size, uint16_t *plength, const char *pformat, ...)
+{
+  va_list args;
+  va_start(args, pformat);
+  int n = vsnprintf(pbuf + *plength, size - *plength, pformat, args);
+  va_end(args);
+  if (n > 0) *plength = *plength + n >= size ? size - 1 : (uint16_t)(*plength + n);
+}
+
+uint16_t OLED_Trace_Format(const OLED_TraceStatsTypeDef *pstats, char *pbuf, uint16_t size)
+{
+  uint16_t length = 0;
+  if (0 == size) return 0;
+  pbuf[0] = '\0';
+#  define OLED_TRACE_APPEND(...) OLED_Trace_Append(pbuf, size, &length, __VA_ARGS__)
+  OLED_TRACE_APPEND("%-14s %10s %8s %10s %10s\n", "op", "calls", "errors", "avg", "max");
+  for (uint8_t op = 0; op < OLED_TRACE_OP_COUNT; ++op) {
+    const OLED_TraceOpStatsTypeDef *pop = &pstats->ops[op];
+    if (0 == pop->calls) continue;
+    OLED_TRACE_APPEND("%-14s %10lu %8lu %10lu %10lu\n", s_oled_trace_names[op], (unsigned long)pop->calls,
+                      (unsigned long)pop->errors, (unsigned long)(pop->total / pop->calls), (unsigned long)pop->max);
+  }
+  OLED_TRACE_APPEND("bytes: cmd %lu data %lu\n", (unsigned long)pstats->cmd_bytes, (unsigned long)pstats->data_bytes);
+  OLED_TRACE_APPEND("refresh latency:");
+  for (uint8_t bucket = 0; bucket < OLED_TRACE_HIST_BUCKETS; ++bucket) {
+    if (0 == pstats->histogram[bucket]) continue;
+    OLED_TRACE_APPEND(" <2^%u:%lu", bucket + 1, (unsigned long)pstats->histogram[bucket]);
+  }
+  OLED_TRACE_APPEND("\n");
+#  undef OLED_TRACE_APPEND
+  return length;
+}
+
+#  if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#    define OLED_DEMCR (*(volatile uint32_t *)0xE000EDFCU)     // 调试异常与监控控制寄存器
+#    define OLED_DWT_CTRL (*(volatile uint32_t *)0xE0001000U)    // DWT控制寄存器
+#    define OLED_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004U)  // DWT周期计数器
+#    define OLED_DWT_LAR (*(volatile uint32_t *)0xE0001FB0U)     // DWT锁定访问寄存器，Cortex-M7需要先解锁
+
+void OLED_Trace_DWT_Enable(void)
+{
+  OLED_DEMCR |= 1UL << 24;  // TRCENA
+  OLED_DWT_LAR = 0xC5ACCE55U;
+  OLED_DWT_CYCCNT = 0;
+  OLED_DWT_CTRL |= 1UL;  // CYCCNTENA
+}
+
+uint32_t OLED_Trace_Clock_DWT(void) { return OLED_DWT_CYCCNT; }
+#  endif
+
+#  if defined(__unix__) || defined(__APPLE__)
+#    include <time.h>
+
+uint32_t OLED_Trace_Clock_Host(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+}
+#  endif
+
+#endif  // OLED_USING_TRACE
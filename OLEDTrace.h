@@ -0,0 +1,137 @@
+/**
+ * @Description 性能统计，定义OLED_USING_TRACE后记录每类操作的次数、耗时、传输字节数、错误数与刷新延迟分布
+ * @note 时间单位由用户提供的时间戳函数决定，Cortex-M上可以用DWT周期计数器，主机上可以用clock_gettime
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDTRACE_H
+#define OLEDTRACE_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include <stdint.h>
+
+#ifdef OLED_USING_TRACE
+
+#  ifndef OLED_TRACE_HIST_BUCKETS
+#    define OLED_TRACE_HIST_BUCKETS 24  // 刷新延迟直方图的桶数，第i个桶统计[2^i, 2^(i+1))，最后一个桶统计其余所有
+#  endif
+
+/**
+ * @brief 统计的操作
+ */
+typedef enum {
+  OLED_TRACE_REFRESH = 0x00U,        // 同步刷新，OLED_Refresh_GSRAM的整个过程
+  OLED_TRACE_REFRESH_ASYNC = 0x01U,  // 异步刷新，从发起到最后一次传输完成
+  OLED_TRACE_WRITE_CMD = 0x02U,      // OLED_WriteCmd
+  OLED_TRACE_CMD_TRANSFER = 0x03U,   // 一次命令传输
+  OLED_TRACE_DATA_TRANSFER = 0x04U,  // 一次显示数据传输，异步刷新时到OLED_Transmit_Done为止
+  OLED_TRACE_LIST_TRANSFER = 0x05U,  // 一次分段列表传输
+  OLED_TRACE_OP_COUNT = 0x06U,
+} OLED_TraceOpTypeDef;
+
+/**
+ * @brief 一类操作的统计
+ */
+typedef struct {
+  uint32_t calls;   // 完成的次数
+  uint32_t errors;  // 其中失败的次数
+  uint64_t total;   // 累计耗时
+  uint32_t max;     // 单次最长耗时
+} OLED_TraceOpStatsTypeDef;
+
+/**
+ * @brief 统计结果
+ */
+typedef struct {
+  OLED_TraceOpStatsTypeDef ops[OLED_TRACE_OP_COUNT];  // 按OLED_TraceOpTypeDef索引
+  uint32_t cmd_bytes;                                  // 命令字节数
+  uint32_t data_bytes;                                 // 显示数据字节数
+  uint32_t histogram[OLED_TRACE_HIST_BUCKETS];         // 同步与异步刷新的延迟分布
+} OLED_TraceStatsTypeDef;
+
+/**
+ * @brief 一块屏幕的统计，挂在实例的ptrace上
+ */
+typedef struct {
+  uint32_t (*pclock)(void);            // 时间戳函数，允许回绕
+  uint32_t start[OLED_TRACE_OP_COUNT];  // 每类操作正在进行的那一次的开始时间
+  OLED_TraceStatsTypeDef stats;         // 统计结果
+} OLED_TraceTypeDef;
+
+/**
+ * 初始化统计
+ * @param ptrace 统计
+ * @param pclock 时间戳函数，例如OLED_Trace_Clock_DWT/OLED_Trace_Clock_Host
+ */
+void OLED_Trace_Init(OLED_TraceTypeDef *ptrace, uint32_t (*pclock)(void));
+
+/**
+ * 清零统计结果，正在进行的操作仍然按原来的开始时间计时
+ * @param ptrace 统计
+ */
+void OLED_Trace_Reset(OLED_TraceTypeDef *ptrace);
+
+/**
+ * 取得统计结果的副本
+ * @param ptrace 统计
+ * @param pstats 输出
+ */
+void OLED_Trace_Get_Stats(const OLED_TraceTypeDef *ptrace, OLED_TraceStatsTypeDef *pstats);
+
+/**
+ * 一次操作开始，由驱动调用
+ * @note 同一类操作同时只能有一次在进行
+ * @param ptrace 统计
+ * @param op 操作
+ */
+void OLED_Trace_Begin(OLED_TraceTypeDef *ptrace, OLED_TraceOpTypeDef op);
+
+/**
+ * 一次操作结束
+ * @param ptrace 统计
+ * @param op 操作
+ * @param failed 操作失败时为1
+ */
+void OLED_Trace_End(OLED_TraceTypeDef *ptrace, OLED_TraceOpTypeDef op, uint8_t failed);
+
+/**
+ * 记录一次传输的字节数
+ * @param ptrace 统计
+ * @param mode 0->命令;1->数据
+ * @param size 字节数
+ */
+void OLED_Trace_Bytes(OLED_TraceTypeDef *ptrace, uint8_t mode, uint16_t size);
+
+/**
+ * 把统计结果格式化成文本，每类操作一行，之后是字节数和刷新延迟分布
+ * @param pstats 统计结果
+ * @param pbuf 输出缓存
+ * @param size 缓存大小，放不下时截断
+ * @return 写入的字符数(不含结尾的'\0')
+ */
+uint16_t OLED_Trace_Format(const OLED_TraceStatsTypeDef *pstats, char *pbuf, uint16_t size);
+
+#  if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+/**
+ * 打开DWT周期计数器，之后OLED_Trace_Clock_DWT返回CPU时钟周期数
+ */
+void OLED_Trace_DWT_Enable(void);
+uint32_t OLED_Trace_Clock_DWT(void);
+#  endif
+
+#  if defined(__unix__) || defined(__APPLE__)
+/**
+ * 主机上的时间戳，单位为纳秒，约4.3秒回绕一次
+ */
+uint32_t OLED_Trace_Clock_Host(void);
+#  endif
+
+#endif  // OLED_USING_TRACE
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDTRACE_H
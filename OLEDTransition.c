@@ -0,0 +1,334 @@
+/**
+ * @Description 转场动画，每一步按列、按页用字节运算把旧画面和新画面合成到显存，只标记真正改变的字节
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDTransition.h"
+
+#define OLED_TRANSITION_NONE INT16_MIN  // 显存中还没有合成过的画面
+#define OLED_DISSOLVE_LEVELS 64         // 溶解级数，对应8x8抖动矩阵
+
+/**
+ * @brief 缓动曲线，t每增加4取一项，共65项，依次为t^2、1 - (1 - t)^2、3t^2 - 2t^3，换算到0~255
+ */
+static const uint8_t s_oled_ease_tables[3][65] = {
+    {0,   0,   0,   1,   1,   2,   2,   3,   4,   5,   6,   8,   9,   11,  12,  14,  16,  18,  20,  22,  25, 27,
+     30,  33,  36,  39,  42,  45,  49,  52,  56,  60,  64,  68,  72,  76,  81,  85,  90,  95,  100, 105, 110, 115,
+     121, 126, 132, 138, 143, 149, 156, 162, 168, 175, 182, 188, 195, 202, 209, 217, 224, 232, 239, 247, 255},
+    {0,   8,   16,  23,  31,  38,  46,  53,  60,  67,  73,  80,  87,  93,  99,  106, 112, 117, 123, 129, 134, 140,
+     145, 150, 155, 160, 165, 170, 174, 179, 183, 187, 191, 195, 199, 203, 206, 210, 213, 216, 219, 222, 225, 228,
+     230, 233, 235, 237, 239, 241, 243, 244, 246, 247, 249, 250, 251, 252, 253, 253, 254, 254, 255, 255, 255},
+    {0,   0,   1,   2,   3,   4,   6,   8,   11,  14,  17,  20,  24,  27,  31,  35,  40,  44,  49,  54,  59,  64,
+     70,  75,  81,  86,  92,  98,  104, 110, 116, 122, 128, 133, 139, 145, 151, 157, 163, 169, 174, 180, 185, 191,
+     196, 201, 206, 211, 215, 220, 224, 228, 231, 235, 238, 241, 244, 247, 249, 251, 252, 253, 254, 255, 255},
+};
+
+/**
+ * @brief 溶解掩码，第L级中第x % 8列的字节，8x8 Bayer矩阵中小于L的点置1，级数增加时只会新增点
+ */
+static const uint8_t s_oled_dissolve_masks[OLED_DISSOLVE_LEVELS + 1][8] = {
+    {0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U},
+    {0x01U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U},
+    {0x01U, 0x00U, 0x00U, 0x00U, 0x10U, 0x00U, 0x00U, 0x00U},
+    {0x01U, 0x00U, 0x00U, 0x00U, 0x11U, 0x00U, 0x00U, 0x00U},
+    {0x11U, 0x00U, 0x00U, 0x00U, 0x11U, 0x00U, 0x00U, 0x00U},
+    {0x11U, 0x00U, 0x04U, 0x00U, 0x11U, 0x00U, 0x00U, 0x00U},
+    {0x11U, 0x00U, 0x04U, 0x00U, 0x11U, 0x00U, 0x40U, 0x00U},
+    {0x11U, 0x00U, 0x04U, 0x00U, 0x11U, 0x00U, 0x44U, 0x00U},
+    {0x11U, 0x00U, 0x44U, 0x00U, 0x11U, 0x00U, 0x44U, 0x00U},
+    {0x11U, 0x00U, 0x45U, 0x00U, 0x11U, 0x00U, 0x44U, 0x00U},
+    {0x11U, 0x00U, 0x45U, 0x00U, 0x11U, 0x00U, 0x54U, 0x00U},
+    {0x11U, 0x00U, 0x45U, 0x00U, 0x11U, 0x00U, 0x55U, 0x00U},
+    {0x11U, 0x00U, 0x55U, 0x00U, 0x11U, 0x00U, 0x55U, 0x00U},
+    {0x15U, 0x00U, 0x55U, 0x00U, 0x11U, 0x00U, 0x55U, 0x00U},
+    {0x15U, 0x00U, 0x55U, 0x00U, 0x51U, 0x00U, 0x55U, 0x00U},
+    {0x15U, 0x00U, 0x55U, 0x00U, 0x55U, 0x00U, 0x55U, 0x00U},
+    {0x55U, 0x00U, 0x55U, 0x00U, 0x55U, 0x00U, 0x55U, 0x00U},
+    {0x55U, 0x02U, 0x55U, 0x00U, 0x55U, 0x00U, 0x55U, 0x00U},
+    {0x55U, 0x02U, 0x55U, 0x00U, 0x55U, 0x20U, 0x55U, 0x00U},
+    {0x55U, 0x02U, 0x55U, 0x00U, 0x55U, 0x22U, 0x55U, 0x00U},
+    {0x55U, 0x22U, 0x55U, 0x00U, 0x55U, 0x22U, 0x55U, 0x00U},
+    {0x55U, 0x22U, 0x55U, 0x08U, 0x55U, 0x22U, 0x55U, 0x00U},
+    {0x55U, 0x22U, 0x55U, 0x08U, 0x55U, 0x22U, 0x55U, 0x80U},
+    {0x55U, 0x22U, 0x55U, 0x08U, 0x55U, 0x22U, 0x55U, 0x88U},
+    {0x55U, 0x22U, 0x55U, 0x88U, 0x55U, 0x22U, 0x55U, 0x88U},
+    {0x55U, 0x22U, 0x55U, 0x8AU, 0x55U, 0x22U, 0x55U, 0x88U},
+    {0x55U, 0x22U, 0x55U, 0x8AU, 0x55U, 0x22U, 0x55U, 0xA8U},
+    {0x55U, 0x22U, 0x55U, 0x8AU, 0x55U, 0x22U, 0x55U, 0xAAU},
+    {0x55U, 0x22U, 0x55U, 0xAAU, 0x55U, 0x22U, 0x55U, 0xAAU},
+    {0x55U, 0x2AU, 0x55U, 0xAAU, 0x55U, 0x22U, 0x55U, 0xAAU},
+    {0x55U, 0x2AU, 0x55U, 0xAAU, 0x55U, 0xA2U, 0x55U, 0xAAU},
+    {0x55U, 0x2AU, 0x55U, 0xAAU, 0x55U, 0xAAU, 0x55U, 0xAAU},
+    {0x55U, 0xAAU, 0x55U, 0xAAU, 0x55U, 0xAAU, 0x55U, 0xAAU},
+    {0x55U, 0xABU, 0x55U, 0xAAU, 0x55U, 0xAAU, 0x55U, 0xAAU},
+    {0x55U, 0xABU, 0x55U, 0xAAU, 0x55U, 0xBAU, 0x55U, 0xAAU},
+    {0x55U, 0xABU, 0x55U, 0xAAU, 0x55U, 0xBBU, 0x55U, 0xAAU},
+    {0x55U, 0xBBU, 0x55U, 0xAAU, 0x55U, 0xBBU, 0x55U, 0xAAU},
+    {0x55U, 0xBBU, 0x55U, 0xAEU, 0x55U, 0xBBU, 0x55U, 0xAAU},
+    {0x55U, 0xBBU, 0x55U, 0xAEU, 0x55U, 0xBBU, 0x55U, 0xEAU},
+    {0x55U, 0xBBU, 0x55U, 0xAEU, 0x55U, 0xBBU, 0x55U, 0xEEU},
+    {0x55U, 0xBBU, 0x55U, 0xEEU, 0x55U, 0xBBU, 0x55U, 0xEEU},
+    {0x55U, 0xBBU, 0x55U, 0xEFU, 0x55U, 0xBBU, 0x55U, 0xEEU},
+    {0x55U, 0xBBU, 0x55U, 0xEFU, 0x55U, 0xBBU, 0x55U, 0xFEU},
+    {0x55U, 0xBBU, 0x55U, 0xEFU, 0x55U, 0xBBU, 0x55U, 0xFFU},
+    {0x55U, 0xBBU, 0x55U, 0xFFU, 0x55U, 0xBBU, 0x55U, 0xFFU},
+    {0x55U, 0xBFU, 0x55U, 0xFFU, 0x55U, 0xBBU, 0x55U, 0xFFU},
+    {0x55U, 0xBFU, 0x55U, 0xFFU, 0x55U, 0xFBU, 0x55U, 0xFFU},
+    {0x55U, 0xBFU, 0x55U, 0xFFU, 0x55U, 0xFFU, 0x55U, 0xFFU},
+    {0x55U, 0xFFU, 0x55U, 0xFFU, 0x55U, 0xFFU, 0x55U, 0xFFU},
+    {0x57U, 0xFFU, 0x55U, 0xFFU, 0x55U, 0xFFU, 0x55U, 0xFFU},
+    {0x57U, 0xFFU, 0x55U, 0xFFU, 0x75U, 0xFFU, 0x55U, 0xFFU},
+    {0x57U, 0xFFU, 0x55U, 0xFFU, 0x77U, 0xFFU, 0x55U, 0xFFU},
+    {0x77U, 0xFFU, 0x55U, 0xFFU, 0x77U, 0xFFU, 0x55U, 0xFFU},
+    {0x77U, 0xFFU, 0x5DU, 0xFFU, 0x77U, 0xFFU, 0x55U, 0xFFU},
+    {0x77U, 0xFFU, 0x5DU, 0xFFU, 0x77U, 0xFFU, 0xD5U, 0xFFU},
+    {0x77U, 0xFFU, 0x5DU, 0xFFU, 0x77U, 0xFFU, 0xDDU, 0xFFU},
+    {0x77U, 0xFFU, 0xDDU, 0xFFU, 0x77U, 0xFFU, 0xDDU, 0xFFU},
+    {0x77U, 0xFFU, 0xDFU, 0xFFU, 0x77U, 0xFFU, 0xDDU, 0xFFU},
+    {0x77U, 0xFFU, 0xDFU, 0xFFU, 0x77U, 0xFFU, 0xFDU, 0xFFU},
+    {0x77U, 0xFFU, 0xDFU, 0xFFU, 0x77U, 0xFFU, 0xFFU, 0xFFU},
+    {0x77U, 0xFFU, 0xFFU, 0xFFU, 0x77U, 0xFFU, 0xFFU, 0xFFU},
+    {0x7FU, 0xFFU, 0xFFU, 0xFFU, 0x77U, 0xFFU, 0xFFU, 0xFFU},
+    {0x7FU, 0xFFU, 0xFFU, 0xFFU, 0xF7U, 0xFFU, 0xFFU, 0xFFU},
+    {0x7FU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU},
+    {0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU},
+};
+
+uint8_t OLED_Ease(OLED_EaseTypeDef ease, uint8_t t)
+{
+  if (OLED_EASE_LINEAR == ease || ease > OLED_EASE_IN_OUT) return t;
+  if (255 == t) return 255;
+  const uint8_t *ptable = s_oled_ease_tables[ease - OLED_EASE_IN];
+  uint8_t index = t >> 2, frac = t & 3;
+  return (uint8_t)(ptable[index] + (((ptable[index + 1] - ptable[index]) * frac) >> 2));
+}
+
+void OLED_Transition_Init(OLED_TransitionTypeDef *ptrans, OLED_HandleTypeDef *phandle,
+                          OLED_FrameSchedulerTypeDef *psched)
+{
+  memset(ptrans, 0, sizeof(OLED_TransitionTypeDef));
+  ptrans->phandle = NULL != phandle ? phandle : &g_oled_handle;
+  ptrans->psched = psched;
+  ptrans->value = OLED_TRANSITION_NONE;
+  ptrans->finished = 1;
+}
+
+void OLED_Transition_Start(OLED_TransitionTypeDef *ptrans, const uint8_t *psource, const uint8_t *ptarget,
+                           OLED_TransitionEffectTypeDef effect, OLED_EaseTypeDef ease, uint32_t duration, uint32_t now)
+{
+  ptrans->psource = psource;
+  ptrans->ptarget = ptarget;
+  ptrans->effect = effect;
+  ptrans->ease = ease;
+  ptrans->start = now;
+  ptrans->duration = duration;
+  ptrans->value = OLED_TRANSITION_NONE;
+  ptrans->finished = 0;
+}
+
+/**
+ * 读取画面中第x列从第row行起的8行，超出画面的行为0
+ * @param pframe 画面
+ * @param width 画面宽度
+ * @param pages 画面页数
+ * @param x 列
+ * @param row 起始行，可以为负数
+ * @return 8行组成的字节，低位在上
+ */
+static uint8_t OLED_Transition_Rows(const uint8_t *pframe, uint8_t width, uint8_t pages, uint8_t x, int16_t row)
+{
+  int16_t page = (int16_t)((row + 8 * OLED_MAX_PAGE_SIZE) / 8 - OLED_MAX_PAGE_SIZE);
+  uint8_t shift = (uint8_t)(row - page * 8), value = 0;
+  if (page >= 0 && page < pages) value = pframe[page * width + x] >> shift;
+  if (0 != shift && page + 1 >= 0 && page + 1 < pages)
+    value |= (uint8_t)(pframe[(page + 1) * width + x] << (8 - shift));
+  return value;
+}
+
+/**
+ * 计算效果参数为value时画面中的一个字节
+ * @param ptrans 转场
+ * @param value 效果参数
+ * @param page 页
+ * @param x 列
+ * @return 合成后的字节
+ */
+static uint8_t OLED_Transition_Byte(const OLED_TransitionTypeDef *ptrans, int16_t value, uint8_t page, uint8_t x)
+{
+  const OLED_HandleTypeDef *phandle = ptrans->phandle;
+  const uint8_t *psource = ptrans->psource, *ptarget = ptrans->ptarget;
+  uint16_t index = page * phandle->width + x;
+  int16_t width = phandle->width, height = phandle->pages * 8, sx, row, rows;
+  uint8_t mask;
+  switch (ptrans->effect) {
+    case OLED_TRANSITION_SLIDE_LEFT:
+      sx = x + value;
+      return sx < width ? psource[page * width + sx] : ptarget[page * width + sx - width];
+    case OLED_TRANSITION_SLIDE_RIGHT:
+      sx = x - value;
+      return sx >= 0 ? psource[page * width + sx] : ptarget[page * width + sx + width];
+    case OLED_TRANSITION_SLIDE_UP:
+      row = page * 8 + value;
+      return OLED_Transition_Rows(psource, phandle->width, phandle->pages, x, row) |
+             OLED_Transition_Rows(ptarget, phandle->width, phandle->pages, x, row - height);
+    case OLED_TRANSITION_SLIDE_DOWN:
+      row = page * 8 - value;
+      return OLED_Transition_Rows(psource, phandle->width, phandle->pages, x, row) |
+             OLED_Transition_Rows(ptarget, phandle->width, phandle->pages, x, row + height);
+    case OLED_TRANSITION_WIPE_LEFT:
+      return x >= width - value ? ptarget[index] : psource[index];
+    case OLED_TRANSITION_WIPE_RIGHT:
+      return x < value ? ptarget[index] : psource[index];
+    case OLED_TRANSITION_WIPE_UP:
+    case OLED_TRANSITION_WIPE_DOWN:
+      // 这一页中显示新画面的行组成掩码
+      rows = (OLED_TRANSITION_WIPE_DOWN == ptrans->effect ? value : height - value) - page * 8;
+      rows = rows < 0 ? 0 : (rows > 8 ? 8 : rows);
+      mask = (uint8_t)((1U << rows) - 1U);
+      if (OLED_TRANSITION_WIPE_UP == ptrans->effect) mask = (uint8_t)~mask;
+      return (uint8_t)((psource[index] & ~mask) | (ptarget[index] & mask));
+    case OLED_TRANSITION_DISSOLVE:
+      mask = s_oled_dissolve_masks[value][x & 7];
+      return (uint8_t)((psource[index] & ~mask) | (ptarget[index] & mask));
+    case OLED_TRANSITION_FLIP: {
+      // 前半程旧画面宽度从width收缩到0，后半程新画面从0展开到width，都以中线为轴
+      int16_t visible = width - 2 * value, left;
+      const uint8_t *pframe = psource;
+      if (visible < 0) {
+        visible = -visible;
+        pframe = ptarget;
+      }
+      left = (width - visible) / 2;
+      if (x < left || x >= left + visible) return 0;
+      return pframe[page * width + (x - left) * width / visible];
+    }
+    default:
+      return ptarget[index];
+  }
+}
+
+/**
+ * 计算效果参数从from变为to时可能改变的列范围与页范围
+ * @param ptrans 转场
+ * @param from 显存中画面的效果参数，OLED_TRANSITION_NONE时为整屏
+ * @param to 新的效果参数
+ * @param pwindow 返回x_start, x_end, page_start, page_end
+ */
+static void OLED_Transition_Window(const OLED_TransitionTypeDef *ptrans, int16_t from, int16_t to, int16_t *pwindow)
+{
+  const OLED_HandleTypeDef *phandle = ptrans->phandle;
+  int16_t width = phandle->width, height = phandle->pages * 8;
+  int16_t low = from < to ? from : to, high = from < to ? to : from;
+  pwindow[0] = 0;
+  pwindow[1] = width - 1;
+  pwindow[2] = 0;
+  pwindow[3] = phandle->pages - 1;
+  if (OLED_TRANSITION_NONE == from) return;
+  switch (ptrans->effect) {
+    case OLED_TRANSITION_WIPE_LEFT:
+      pwindow[0] = width - high;
+      pwindow[1] = width - low - 1;
+      break;
+    case OLED_TRANSITION_WIPE_RIGHT:
+      pwindow[0] = low;
+      pwindow[1] = high - 1;
+      break;
+    case OLED_TRANSITION_WIPE_UP:
+      pwindow[2] = (height - high) / 8;
+      pwindow[3] = (height - low - 1) / 8;
+      break;
+    case OLED_TRANSITION_WIPE_DOWN:
+      pwindow[2] = low / 8;
+      pwindow[3] = (high - 1) / 8;
+      break;
+    case OLED_TRANSITION_FLIP: {
+      // 可见部分以中线为轴，较宽的一次覆盖较窄的一次
+      int16_t visible_from = width - 2 * from, visible_to = width - 2 * to, visible;
+      visible_from = visible_from < 0 ? -visible_from : visible_from;
+      visible_to = visible_to < 0 ? -visible_to : visible_to;
+      visible = visible_from > visible_to ? visible_from : visible_to;
+      pwindow[0] = (width - visible) / 2;
+      pwindow[1] = pwindow[0] + visible - 1;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+ * 把画面合成为效果参数value对应的一帧，只在可能改变的范围内计算，按页标记实际改变的列
+ * @param ptrans 转场
+ * @param value 新的效果参数
+ */
+static void OLED_Transition_Compose(OLED_TransitionTypeDef *ptrans, int16_t value)
+{
+  OLED_HandleTypeDef *phandle = ptrans->phandle;
+  int16_t window[4];
+  OLED_Transition_Window(ptrans, ptrans->value, value, window);
+  for (int16_t page = window[2]; page <= window[3]; page++) {
+    uint8_t *prow = phandle->pbuffer + page * phandle->width;
+    int16_t first = -1, last = -1;
+    for (int16_t x = window[0]; x <= window[1]; x++) {
+      uint8_t byte = OLED_Transition_Byte(ptrans, value, (uint8_t)page, (uint8_t)x);
+      if (byte == prow[x]) continue;
+      prow[x] = byte;
+      if (first < 0) first = x;
+      last = x;
+      ptrans->stats.changed++;
+    }
+    if (window[1] >= window[0]) ptrans->stats.bytes += window[1] - window[0] + 1;
+    if (first < 0) continue;
+    OLEDH_MARK_DIRTY(phandle, first, last, page, page);
+    (void)last;
+  }
+  ptrans->value = value;
+  ptrans->stats.steps++;
+}
+
+uint8_t OLED_Transition_Render(OLED_TransitionTypeDef *ptrans, uint8_t t)
+{
+  const OLED_HandleTypeDef *phandle = ptrans->phandle;
+  uint8_t progress = OLED_Ease(ptrans->ease, t);
+  uint32_t changed = ptrans->stats.changed;
+  int16_t value;
+  switch (ptrans->effect) {
+    case OLED_TRANSITION_SLIDE_UP:
+    case OLED_TRANSITION_SLIDE_DOWN:
+    case OLED_TRANSITION_WIPE_UP:
+    case OLED_TRANSITION_WIPE_DOWN:
+      value = (int16_t)(progress * phandle->pages * 8 / 255);
+      break;
+    case OLED_TRANSITION_DISSOLVE:
+      value = (int16_t)(progress * OLED_DISSOLVE_LEVELS / 255);
+      break;
+    default:
+      value = (int16_t)(progress * phandle->width / 255);
+      break;
+  }
+  if (255 == t) ptrans->finished = 1;
+  if (value == ptrans->value) {
+    ptrans->stats.skipped++;
+    return 0;
+  }
+  OLED_Transition_Compose(ptrans, value);
+  return changed != ptrans->stats.changed;
+}
+
+OLED_StatusTypeDef OLED_Transition_Tick(OLED_TransitionTypeDef *ptrans, uint32_t now)
+{
+  if (!ptrans->finished) {
+    uint32_t elapsed = now - ptrans->start;
+    uint8_t t = elapsed >= ptrans->duration ? 255 : (uint8_t)((uint64_t)elapsed * 255 / ptrans->duration);
+    if (OLED_Transition_Render(ptrans, t) && NULL != ptrans->psched) OLED_Frame_Request(ptrans->psched);
+  }
+  if (NULL == ptrans->psched) return OLED_OK;
+  return OLED_Frame_Tick(ptrans->psched, now);
+}
+
+uint8_t OLED_Transition_Done(const OLED_TransitionTypeDef *ptrans)
+{
+  if (!ptrans->finished) return 0;
+  return NULL == ptrans->psched || (!ptrans->psched->pending && !ptrans->psched->busy);
+}
@@ -0,0 +1,130 @@
+/**
+ * @Description 转场动画，每一步按列、按页用字节运算把旧画面和新画面合成到显存，只标记真正改变的字节
+ * @note 缓动曲线与溶解掩码都是预先算好的表，每一步的工作量固定，不做浮点运算
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDTRANSITION_H
+#define OLEDTRANSITION_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+#include "OLEDFrame.h"
+
+/**
+ * @brief 转场效果，方向均为屏幕的原始方向，与OLED_ROTATION无关
+ */
+typedef enum {
+  OLED_TRANSITION_SLIDE_LEFT = 0x00U,   // 新画面从右边推入，旧画面向左移出
+  OLED_TRANSITION_SLIDE_RIGHT = 0x01U,  // 新画面从左边推入
+  OLED_TRANSITION_SLIDE_UP = 0x02U,     // 新画面从下边推入，按行移动，不需要按页对齐
+  OLED_TRANSITION_SLIDE_DOWN = 0x03U,   // 新画面从上边推入
+  OLED_TRANSITION_WIPE_LEFT = 0x04U,    // 分界线从右向左扫过，扫过的部分显示新画面
+  OLED_TRANSITION_WIPE_RIGHT = 0x05U,   // 分界线从左向右扫过
+  OLED_TRANSITION_WIPE_UP = 0x06U,      // 分界线从下向上扫过
+  OLED_TRANSITION_WIPE_DOWN = 0x07U,    // 分界线从上向下扫过
+  OLED_TRANSITION_DISSOLVE = 0x08U,     // 按8x8有序抖动表逐点溶解，共64级
+  OLED_TRANSITION_FLIP = 0x09U,         // 翻页，旧画面横向压缩到中线，新画面再从中线展开
+} OLED_TransitionEffectTypeDef;
+
+/**
+ * @brief 缓动曲线
+ */
+typedef enum {
+  OLED_EASE_LINEAR = 0x00U,  // 匀速
+  OLED_EASE_IN = 0x01U,      // 先慢后快
+  OLED_EASE_OUT = 0x02U,     // 先快后慢
+  OLED_EASE_IN_OUT = 0x03U,  // 两头慢中间快
+} OLED_EaseTypeDef;
+
+/**
+ * @brief 转场的统计
+ */
+typedef struct {
+  uint32_t steps;    // 合成的步数
+  uint32_t skipped;  // 进度没有改变画面而跳过的次数
+  uint32_t bytes;    // 合成时计算的字节数
+  uint32_t changed;  // 其中实际改变、标记为需要刷新的字节数
+} OLED_TransitionStatsTypeDef;
+
+/**
+ * @brief 一次转场，由用户分配
+ * @note 旧画面与新画面的格式与显存相同，转场期间不能修改；合成结果写入实例的显存
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;          // 显示的屏幕实例
+  OLED_FrameSchedulerTypeDef *psched;   // 帧调度器，可为NULL
+  const uint8_t *psource;               // 旧画面
+  const uint8_t *ptarget;               // 新画面
+  OLED_TransitionEffectTypeDef effect;  // 效果
+  OLED_EaseTypeDef ease;                // 缓动曲线
+  uint32_t start;                       // 开始的时间
+  uint32_t duration;                    // 持续时间，单位与start相同
+  int16_t value;                        // 显存中画面对应的效果参数(位移、分界线、溶解级数)，INT16_MIN表示还没有合成
+  uint8_t finished;                     // 最后一步已经合成
+  OLED_TransitionStatsTypeDef stats;    // 统计
+} OLED_TransitionTypeDef;
+
+/**
+ * 按缓动曲线换算进度，查表后在相邻两项之间线性插值
+ * @param ease 缓动曲线
+ * @param t 时间进度 0~255
+ * @return 画面进度 0~255，t为0、255时分别为0、255
+ */
+uint8_t OLED_Ease(OLED_EaseTypeDef ease, uint8_t t);
+
+/**
+ * 初始化转场
+ * @param ptrans 转场
+ * @param phandle 屏幕实例，为NULL时使用默认实例
+ * @param psched 帧调度器，可为NULL，此时由用户在OLED_Transition_Render之后自行刷新
+ */
+void OLED_Transition_Init(OLED_TransitionTypeDef *ptrans, OLED_HandleTypeDef *phandle,
+                          OLED_FrameSchedulerTypeDef *psched);
+
+/**
+ * 开始一次转场，不合成
+ * @note 可以用同一块缓存作为旧画面并在转场结束后再作为下一次的新画面，但不能是实例的显存
+ * @param ptrans 转场
+ * @param psource 旧画面，大小与实例的显存相同
+ * @param ptarget 新画面
+ * @param effect 效果
+ * @param ease 缓动曲线
+ * @param duration 持续时间，单位与now相同，为0时第一次Tick直接显示新画面
+ * @param now 当前时间
+ */
+void OLED_Transition_Start(OLED_TransitionTypeDef *ptrans, const uint8_t *psource, const uint8_t *ptarget,
+                           OLED_TransitionEffectTypeDef effect, OLED_EaseTypeDef ease, uint32_t duration, uint32_t now);
+
+/**
+ * 按时间进度合成一步，只重新计算这一步可能改变的区域，逐字节比较后只标记改变了的列
+ * @note 效果参数与显存中的画面相同(例如位移不到一列)时直接返回
+ * @param ptrans 转场
+ * @param t 时间进度 0~255，经过缓动曲线换算后决定画面
+ * @return 显存被修改时返回1
+ */
+uint8_t OLED_Transition_Render(OLED_TransitionTypeDef *ptrans, uint8_t t);
+
+/**
+ * 按当前时间合成一步，画面有变化时向帧调度器提交刷新请求，再调用OLED_Frame_Tick
+ * @note 每个帧周期最多发出一帧，合成比发送快时中间的进度被合并，转场的总时间不变
+ * @param ptrans 转场
+ * @param now 当前时间，单调递增，允许回绕
+ * @return 帧调度的结果，没有帧调度器时返回OLED_OK
+ */
+OLED_StatusTypeDef OLED_Transition_Tick(OLED_TransitionTypeDef *ptrans, uint32_t now);
+
+/**
+ * 转场是否已经结束
+ * @param ptrans 转场
+ * @return 最后一步已经合成并且帧调度器已经把它发出时返回1
+ */
+uint8_t OLED_Transition_Done(const OLED_TransitionTypeDef *ptrans);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDTRANSITION_H
@@ -0,0 +1,350 @@
+/**
+ * @Description 保留模式控件，每个控件记住自己的矩形与内容，只有内容变化时才重新绘制自己的矩形
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "OLEDWidget.h"
+#include "OLEDGraphics.h"
+
+#define OLED_WIDGET_BAR_INSET 2    // 进度条边框与间隙占用的宽度
+#define OLED_WIDGET_MAX_DECIMALS 9  // 数值最多的小数位数
+#define OLED_WIDGET_VALUE_SIZE 16   // 格式化数值的缓存大小，足够放下符号、10位数字、小数点与补齐的0
+
+void OLED_Widget_Screen_Init(OLED_WidgetScreenTypeDef *pscreen, OLED_HandleTypeDef *phandle)
+{
+  memset(pscreen, 0, sizeof(OLED_WidgetScreenTypeDef));
+  pscreen->phandle = NULL != phandle ? phandle : &g_oled_handle;
+}
+
+void OLED_Widget_Add(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget)
+{
+  OLED_WidgetTypeDef **pplast = &pscreen->pfirst;
+  while (NULL != *pplast) pplast = &(*pplast)->pnext;
+  pwidget->pnext = NULL;
+  *pplast = pwidget;
+  OLED_Widget_Invalidate(pscreen, pwidget);
+}
+
+/**
+ * 控件的公共部分初始化
+ * @param pwidget 控件
+ * @param kind 类型
+ */
+static void OLED_Widget_Init(OLED_WidgetTypeDef *pwidget, OLED_WidgetKindTypeDef kind, int16_t x, int16_t y,
+                             uint8_t width, uint8_t height)
+{
+  memset(pwidget, 0, sizeof(OLED_WidgetTypeDef));
+  pwidget->kind = kind;
+  pwidget->x = x;
+  pwidget->y = y;
+  pwidget->width = width;
+  pwidget->height = height;
+  pwidget->flags = OLED_WIDGET_DIRTY;
+  pwidget->drawn = OLED_WIDGET_UNDRAWN;
+}
+
+void OLED_Widget_Init_Label(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width,
+                            const OLED_FontTypeDef *pfont, const char *ptext)
+{
+  OLED_Widget_Init(pwidget, OLED_WIDGET_LABEL, x, y, width, pfont->height);
+  pwidget->pfont = pfont;
+  pwidget->ptext = ptext;
+}
+
+void OLED_Widget_Init_Value(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width,
+                            const OLED_FontTypeDef *pfont, uint8_t decimals, const char *punit)
+{
+  OLED_Widget_Init(pwidget, OLED_WIDGET_VALUE, x, y, width, pfont->height);
+  pwidget->flags |= OLED_WIDGET_ALIGN_RIGHT;
+  pwidget->pfont = pfont;
+  pwidget->ptext = punit;
+  pwidget->decimals = decimals > OLED_WIDGET_MAX_DECIMALS ? OLED_WIDGET_MAX_DECIMALS : decimals;
+}
+
+void OLED_Widget_Init_Bar(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                          int32_t min, int32_t max)
+{
+  OLED_Widget_Init(pwidget, OLED_WIDGET_BAR, x, y, width, height);
+  pwidget->value = min;
+  pwidget->min = min;
+  pwidget->max = max;
+}
+
+void OLED_Widget_Init_Icon(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                           const uint8_t *pbitmap)
+{
+  OLED_Widget_Init(pwidget, OLED_WIDGET_ICON, x, y, width, height);
+  pwidget->pbitmap = pbitmap;
+}
+
+void OLED_Widget_Init_List(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                           const OLED_FontTypeDef *pfont, const char *const *pitems, uint8_t count)
+{
+  OLED_Widget_Init(pwidget, OLED_WIDGET_LIST, x, y, width, height);
+  pwidget->pfont = pfont;
+  pwidget->pitems = pitems;
+  pwidget->count = count;
+}
+
+/**
+ * 根据设置的结果标记控件
+ * @param pscreen 控件屏幕
+ * @param pwidget 控件
+ * @param changed 显示的内容有变化
+ */
+static void OLED_Widget_Touch(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, uint8_t changed)
+{
+  if (!changed) {
+    pscreen->stats.skipped++;
+    return;
+  }
+  pwidget->flags |= OLED_WIDGET_DIRTY;
+  pscreen->dirty = 1;
+}
+
+void OLED_Widget_Set_Text(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, const char *ptext)
+{
+  uint8_t changed = pwidget->ptext != ptext;
+  pwidget->ptext = ptext;
+  OLED_Widget_Touch(pscreen, pwidget, changed);
+}
+
+/**
+ * 计算进度条的长度
+ * @param pwidget 进度条控件
+ * @param value 当前值
+ * @return 填充部分的像素数
+ */
+static uint8_t OLED_Widget_Bar_Level(const OLED_WidgetTypeDef *pwidget, int32_t value)
+{
+  int16_t length = (pwidget->height > pwidget->width ? pwidget->height : pwidget->width) - 2 * OLED_WIDGET_BAR_INSET;
+  if (length <= 0 || value <= pwidget->min || pwidget->max <= pwidget->min) return 0;
+  if (value >= pwidget->max) return length;
+  return (uint8_t)((int64_t)(value - pwidget->min) * length / ((int64_t)pwidget->max - pwidget->min));
+}
+
+/**
+ * 计算列表的可见行数
+ * @param pwidget 列表控件
+ * @return 行数，至少为1
+ */
+static uint8_t OLED_Widget_List_Rows(const OLED_WidgetTypeDef *pwidget)
+{
+  uint8_t rows = pwidget->height / pwidget->pfont->height;
+  return rows > 0 ? rows : 1;
+}
+
+void OLED_Widget_Set_Value(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, int32_t value)
+{
+  uint8_t changed;
+  switch (pwidget->kind) {
+    case OLED_WIDGET_BAR: {
+      uint8_t level = OLED_Widget_Bar_Level(pwidget, value);
+      changed = level != pwidget->level;
+      pwidget->level = level;
+      break;
+    }
+    case OLED_WIDGET_LIST: {
+      if (0 == pwidget->count) return;
+      if (value < 0) value = 0;
+      if (value >= pwidget->count) value = pwidget->count - 1;
+      uint8_t rows = OLED_Widget_List_Rows(pwidget);
+      if (value < pwidget->top) pwidget->top = value;
+      if (value >= pwidget->top + rows) pwidget->top = value - rows + 1;
+      changed = value != pwidget->value;
+      break;
+    }
+    default:
+      changed = value != pwidget->value;
+      break;
+  }
+  pwidget->value = value;
+  OLED_Widget_Touch(pscreen, pwidget, changed);
+}
+
+void OLED_Widget_Set_Bitmap(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, const uint8_t *pbitmap)
+{
+  uint8_t changed = pwidget->pbitmap != pbitmap;
+  pwidget->pbitmap = pbitmap;
+  OLED_Widget_Touch(pscreen, pwidget, changed);
+}
+
+void OLED_Widget_Set_Flags(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, uint8_t mask,
+                           uint8_t flags)
+{
+  mask &= ~OLED_WIDGET_DIRTY;
+  uint8_t changed = (pwidget->flags & mask) != (flags & mask);
+  pwidget->flags = (pwidget->flags & ~mask) | (flags & mask);
+  if (changed) pwidget->drawn = OLED_WIDGET_UNDRAWN;
+  OLED_Widget_Touch(pscreen, pwidget, changed);
+}
+
+void OLED_Widget_Invalidate(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget)
+{
+  for (OLED_WidgetTypeDef *p = NULL != pwidget ? pwidget : pscreen->pfirst; NULL != p; p = p->pnext) {
+    p->flags |= OLED_WIDGET_DIRTY;
+    p->drawn = OLED_WIDGET_UNDRAWN;
+    if (NULL != pwidget) break;
+  }
+  pscreen->dirty = 1;
+}
+
+/**
+ * 把定点数格式化成字符串，从缓存末尾向前写
+ * @param pend 缓存末尾
+ * @param value 数值
+ * @param decimals 小数位数
+ * @return 字符串的开头
+ */
+static char *OLED_Widget_Format(char *pend, int32_t value, uint8_t decimals)
+{
+  uint32_t magnitude = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+  uint8_t digits = 0;
+  *--pend = '\0';
+  do {
+    *--pend = (char)('0' + magnitude % 10);
+    magnitude /= 10;
+    if (++digits == decimals) *--pend = '.';
+  } while (0 != magnitude || digits <= decimals);
+  if (value < 0) *--pend = '-';
+  return pend;
+}
+
+/**
+ * 绘制一行文字，只绘制完整落在右边界之内的字形
+ * @param x 起点横坐标
+ * @param right 右边界(不含)
+ * @param y 纵坐标
+ * @param pstr UTF-8字符串，遇到'\n'结束
+ * @param rop 光栅操作
+ * @return 绘制结束的横坐标
+ */
+static int16_t OLED_Widget_Draw_String(OLED_HandleTypeDef *phandle, int16_t x, int16_t right, int16_t y,
+                                       const OLED_FontTypeDef *pfont, const char *pstr, OLED_RopTypeDef rop)
+{
+  OLED_GlyphInfoTypeDef info;
+  uint32_t code;
+  while (0 != (code = OLED_UTF8_Next(&pstr)) && '\n' != code) {
+    if (OLED_OK != OLED_Font_Get_Glyph(pfont, code, &info)) {
+      if (x + pfont->height / 2 > right) break;
+      x += OLEDH_Draw_Glyph(phandle, x, y, pfont, code, rop);  // 缺字的方框
+      continue;
+    }
+    if (x + info.width > right) break;
+    OLEDH_Draw_Bitmap(phandle, x, y, info.width, info.height, info.pbitmap, rop);
+    x += info.advance;
+  }
+  return x;
+}
+
+/**
+ * 按控件的对齐方式在一行里绘制两段文字
+ * @param pwidget 控件
+ * @param y 纵坐标
+ * @param pfirst 第一段
+ * @param psecond 紧跟着的第二段，可为NULL
+ * @param rop 光栅操作
+ */
+static void OLED_Widget_Draw_Line(OLED_HandleTypeDef *phandle, const OLED_WidgetTypeDef *pwidget, int16_t y,
+                                  const char *pfirst, const char *psecond, OLED_RopTypeDef rop)
+{
+  int16_t x = pwidget->x, right = pwidget->x + pwidget->width;
+  if (pwidget->flags & (OLED_WIDGET_ALIGN_RIGHT | OLED_WIDGET_ALIGN_CENTER)) {
+    uint16_t width = OLED_Text_Width(pwidget->pfont, pfirst);
+    if (NULL != psecond) width += OLED_Text_Width(pwidget->pfont, psecond);
+    if (width < pwidget->width)
+      x += (pwidget->flags & OLED_WIDGET_ALIGN_RIGHT) ? pwidget->width - width : (pwidget->width - width) / 2;
+  }
+  x = OLED_Widget_Draw_String(phandle, x, right, y, pwidget->pfont, pfirst, rop);
+  if (NULL != psecond) OLED_Widget_Draw_String(phandle, x, right, y, pwidget->pfont, psecond, rop);
+}
+
+/**
+ * 进度条只补画或擦除长度变化的部分
+ * @param pwidget 进度条控件
+ * @param ink 填充部分的状态
+ */
+static void OLED_Widget_Draw_Bar_Delta(OLED_HandleTypeDef *phandle, OLED_WidgetTypeDef *pwidget, uint8_t ink)
+{
+  uint8_t low = pwidget->drawn < pwidget->level ? pwidget->drawn : pwidget->level;
+  uint8_t high = pwidget->drawn < pwidget->level ? pwidget->level : pwidget->drawn;
+  uint8_t state = pwidget->level > pwidget->drawn ? ink : !ink;
+  if (pwidget->height > pwidget->width) {
+    OLEDH_Fill_Rect(phandle, pwidget->x + OLED_WIDGET_BAR_INSET,
+                    pwidget->y + pwidget->height - OLED_WIDGET_BAR_INSET - high,
+                    pwidget->width - 2 * OLED_WIDGET_BAR_INSET, high - low, state);
+  } else {
+    OLEDH_Fill_Rect(phandle, pwidget->x + OLED_WIDGET_BAR_INSET + low, pwidget->y + OLED_WIDGET_BAR_INSET,
+                    high - low, pwidget->height - 2 * OLED_WIDGET_BAR_INSET, state);
+  }
+  pwidget->drawn = pwidget->level;
+}
+
+/**
+ * 重绘一个控件
+ * @param pwidget 控件
+ */
+static void OLED_Widget_Draw(OLED_HandleTypeDef *phandle, OLED_WidgetTypeDef *pwidget)
+{
+  uint8_t ink = !(pwidget->flags & OLED_WIDGET_INVERT);
+  OLED_RopTypeDef rop = ink ? OLED_ROP_OR : OLED_ROP_AND_NOT;
+  if (pwidget->flags & OLED_WIDGET_HIDDEN) {
+    OLEDH_Fill_Rect(phandle, pwidget->x, pwidget->y, pwidget->width, pwidget->height, 0);
+    pwidget->drawn = OLED_WIDGET_UNDRAWN;
+    return;
+  }
+  if (OLED_WIDGET_BAR == pwidget->kind && OLED_WIDGET_UNDRAWN != pwidget->drawn) {
+    OLED_Widget_Draw_Bar_Delta(phandle, pwidget, ink);
+    return;
+  }
+  OLEDH_Fill_Rect(phandle, pwidget->x, pwidget->y, pwidget->width, pwidget->height, !ink);
+  switch (pwidget->kind) {
+    case OLED_WIDGET_LABEL:
+      if (NULL != pwidget->ptext) OLED_Widget_Draw_Line(phandle, pwidget, pwidget->y, pwidget->ptext, NULL, rop);
+      break;
+    case OLED_WIDGET_VALUE: {
+      char buffer[OLED_WIDGET_VALUE_SIZE];
+      char *pnumber = OLED_Widget_Format(buffer + sizeof(buffer), pwidget->value, pwidget->decimals);
+      OLED_Widget_Draw_Line(phandle, pwidget, pwidget->y, pnumber, pwidget->ptext, rop);
+      break;
+    }
+    case OLED_WIDGET_BAR:
+      OLEDH_Draw_Rect(phandle, pwidget->x, pwidget->y, pwidget->width, pwidget->height, ink);
+      pwidget->drawn = 0;
+      OLED_Widget_Draw_Bar_Delta(phandle, pwidget, ink);
+      break;
+    case OLED_WIDGET_ICON:
+      if (NULL != pwidget->pbitmap)
+        OLEDH_Draw_Bitmap(phandle, pwidget->x, pwidget->y, pwidget->width, pwidget->height, pwidget->pbitmap, rop);
+      break;
+    case OLED_WIDGET_LIST: {
+      uint8_t rows = OLED_Widget_List_Rows(pwidget), height = pwidget->pfont->height;
+      for (uint8_t row = 0; row < rows && pwidget->top + row < pwidget->count; ++row) {
+        uint8_t item = pwidget->top + row;
+        int16_t y = pwidget->y + row * height;
+        uint8_t selected = item == pwidget->value;
+        if (selected) OLEDH_Fill_Rect(phandle, pwidget->x, y, pwidget->width, height, ink);
+        OLED_Widget_Draw_Line(phandle, pwidget, y, pwidget->pitems[item], NULL,
+                              selected != ink ? OLED_ROP_OR : OLED_ROP_AND_NOT);
+      }
+      break;
+    }
+  }
+}
+
+uint8_t OLED_Widget_Render(OLED_WidgetScreenTypeDef *pscreen)
+{
+  uint8_t count = 0;
+  pscreen->stats.renders++;
+  if (!pscreen->dirty) return 0;
+  pscreen->dirty = 0;
+  for (OLED_WidgetTypeDef *pwidget = pscreen->pfirst; NULL != pwidget; pwidget = pwidget->pnext) {
+    if (!(pwidget->flags & OLED_WIDGET_DIRTY)) continue;
+    pwidget->flags &= ~OLED_WIDGET_DIRTY;
+    OLED_Widget_Draw(pscreen->phandle, pwidget);
+    ++count;
+  }
+  pscreen->stats.redraws += count;
+  return count;
+}
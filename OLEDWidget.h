@@ -0,0 +1,212 @@
+/**
+ * @Description 保留模式控件，每个控件记住自己的矩形与内容，只有内容变化时才重新绘制自己的矩形
+ * @note 重绘通过绘图函数标记脏区，定义OLED_USING_PARTIAL_REFRESH时刷新只发送改动过的控件
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLEDWIDGET_H
+#define OLEDWIDGET_H
+#ifdef __cplusplus
+extern "C" {
+#endif  // C++ Support
+#include "OLEDDriver.h"
+#include "OLEDFont.h"
+
+#define OLED_WIDGET_DIRTY 0x01U         // 内容变化，等待重绘
+#define OLED_WIDGET_HIDDEN 0x02U        // 隐藏，重绘时只清空矩形
+#define OLED_WIDGET_INVERT 0x04U        // 反色，点亮背景、熄灭前景
+#define OLED_WIDGET_ALIGN_RIGHT 0x08U   // 文字右对齐
+#define OLED_WIDGET_ALIGN_CENTER 0x10U  // 文字居中
+#define OLED_WIDGET_UNDRAWN 0xffU       // 控件还没有画到显存里
+
+/**
+ * @brief 控件类型
+ */
+typedef enum {
+  OLED_WIDGET_LABEL = 0x00U,  // 文字
+  OLED_WIDGET_VALUE = 0x01U,  // 数值，定点小数加单位
+  OLED_WIDGET_BAR = 0x02U,    // 进度条，高度大于宽度时竖直增长
+  OLED_WIDGET_ICON = 0x03U,   // 图标
+  OLED_WIDGET_LIST = 0x04U,   // 列表，选中项反色
+} OLED_WidgetKindTypeDef;
+
+/**
+ * @brief 控件，由用户分配，初始化后挂到OLED_WidgetScreenTypeDef上
+ * @note 控件只在自己的矩形内绘制，超出矩形的文字不绘制；重绘时先清空整个矩形，控件之间不能重叠
+ */
+typedef struct OLED_WidgetTypeDef {
+  struct OLED_WidgetTypeDef *pnext;  // 同一屏幕的下一个控件
+  OLED_WidgetKindTypeDef kind;       // 类型
+  int16_t x;                         // 矩形左上角横坐标(绘图坐标)
+  int16_t y;                         // 矩形左上角纵坐标
+  uint8_t width;                     // 矩形宽度
+  uint8_t height;                    // 矩形高度
+  uint8_t flags;                     // OLED_WIDGET_DIRTY等标志的组合
+  uint8_t decimals;                  // 数值的小数位数
+  const OLED_FontTypeDef *pfont;     // 文字、数值、列表使用的字库
+  const char *ptext;                 // 文字的内容，数值的单位(可为NULL)
+  const char *const *pitems;         // 列表的各项
+  const uint8_t *pbitmap;            // 图标的点阵，格式与OLED_Draw_Bitmap相同，大小为width x height
+  int32_t value;                     // 数值；进度条的当前值；列表的选中项
+  int32_t min;                       // 进度条的最小值
+  int32_t max;                       // 进度条的最大值
+  uint8_t count;                     // 列表的项数
+  uint8_t top;                       // 列表第一个可见项
+  uint8_t level;                     // 进度条按当前值应有的长度，长度不变时不重绘
+  uint8_t drawn;                     // 进度条屏幕上已有的长度，OLED_WIDGET_UNDRAWN表示需要整个重绘
+} OLED_WidgetTypeDef;
+
+/**
+ * @brief 控件重绘的统计
+ */
+typedef struct {
+  uint32_t renders;  // OLED_Widget_Render的调用次数
+  uint32_t redraws;  // 重新绘制的控件数
+  uint32_t skipped;  // 内容没有变化而跳过的设置次数
+} OLED_WidgetStatsTypeDef;
+
+/**
+ * @brief 一块屏幕上的控件
+ */
+typedef struct {
+  OLED_HandleTypeDef *phandle;    // 绘制的屏幕实例
+  OLED_WidgetTypeDef *pfirst;     // 第一个控件，按添加顺序绘制
+  uint8_t dirty;                  // 有控件等待重绘
+  OLED_WidgetStatsTypeDef stats;  // 统计
+} OLED_WidgetScreenTypeDef;
+
+/**
+ * 初始化控件屏幕
+ * @param pscreen 控件屏幕
+ * @param phandle 屏幕实例，为NULL时使用默认实例
+ */
+void OLED_Widget_Screen_Init(OLED_WidgetScreenTypeDef *pscreen, OLED_HandleTypeDef *phandle);
+
+/**
+ * 添加控件，添加后等待第一次绘制
+ * @param pscreen 控件屏幕
+ * @param pwidget 已经初始化的控件，不能重复添加
+ */
+void OLED_Widget_Add(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget);
+
+/**
+ * 初始化文字控件，高度为字高
+ * @param pwidget 控件
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 宽度
+ * @param pfont 字库
+ * @param ptext UTF-8文字，只绘制一行
+ */
+void OLED_Widget_Init_Label(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width,
+                            const OLED_FontTypeDef *pfont, const char *ptext);
+
+/**
+ * 初始化数值控件，默认右对齐
+ * @param pwidget 控件
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 宽度
+ * @param pfont 字库
+ * @param decimals 小数位数，例如value为1234、decimals为2时显示12.34
+ * @param punit 跟在数字后面的单位，可为NULL
+ */
+void OLED_Widget_Init_Value(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width,
+                            const OLED_FontTypeDef *pfont, uint8_t decimals, const char *punit);
+
+/**
+ * 初始化进度条控件，带1像素边框
+ * @param pwidget 控件
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 宽度
+ * @param height 高度，大于宽度时从下往上增长
+ * @param min 最小值
+ * @param max 最大值
+ */
+void OLED_Widget_Init_Bar(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                          int32_t min, int32_t max);
+
+/**
+ * 初始化图标控件
+ * @param pwidget 控件
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 点阵宽度
+ * @param height 点阵高度
+ * @param pbitmap 点阵
+ */
+void OLED_Widget_Init_Icon(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                           const uint8_t *pbitmap);
+
+/**
+ * 初始化列表控件，每项一行，可见行数为height / 字高，选中项超出可见范围时自动滚动
+ * @param pwidget 控件
+ * @param x 左上角横坐标
+ * @param y 左上角纵坐标
+ * @param width 宽度
+ * @param height 高度
+ * @param pfont 字库
+ * @param pitems 各项的UTF-8文字
+ * @param count 项数
+ */
+void OLED_Widget_Init_List(OLED_WidgetTypeDef *pwidget, int16_t x, int16_t y, uint8_t width, uint8_t height,
+                           const OLED_FontTypeDef *pfont, const char *const *pitems, uint8_t count);
+
+/**
+ * 设置文字控件的内容或数值控件的单位
+ * @note 指针相同时认为内容没有变化；在原来的缓存里修改了文字时调用OLED_Widget_Invalidate
+ * @param pscreen 控件屏幕
+ * @param pwidget 控件
+ * @param ptext UTF-8文字
+ */
+void OLED_Widget_Set_Text(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, const char *ptext);
+
+/**
+ * 设置数值控件的数值、进度条的当前值或列表的选中项，显示不变时不重绘
+ * @param pscreen 控件屏幕
+ * @param pwidget 控件
+ * @param value 数值
+ */
+void OLED_Widget_Set_Value(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, int32_t value);
+
+/**
+ * 设置图标控件的点阵，例如切换电池电量图标
+ * @param pscreen 控件屏幕
+ * @param pwidget 控件
+ * @param pbitmap 点阵，大小与初始化时相同
+ */
+void OLED_Widget_Set_Bitmap(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, const uint8_t *pbitmap);
+
+/**
+ * 设置控件的标志，例如隐藏、反色、对齐方式，标志变化时重绘
+ * @param pscreen 控件屏幕
+ * @param pwidget 控件
+ * @param mask 要修改的标志
+ * @param flags 新的值
+ */
+void OLED_Widget_Set_Flags(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget, uint8_t mask,
+                           uint8_t flags);
+
+/**
+ * 标记控件需要重绘
+ * @param pscreen 控件屏幕
+ * @param pwidget 控件，为NULL时标记所有控件，例如整屏被其它内容覆盖之后
+ */
+void OLED_Widget_Invalidate(OLED_WidgetScreenTypeDef *pscreen, OLED_WidgetTypeDef *pwidget);
+
+/**
+ * 重绘所有等待重绘的控件，只修改这些控件的矩形并标记脏区，不发送数据
+ * @note 之后调用OLED_Refresh_GSRAM或OLED_Frame_Request把改动发送到屏幕
+ * @note 没有控件变化时只检查一个标志就返回
+ * @param pscreen 控件屏幕
+ * @return 重绘的控件数，为0时不需要刷新
+ */
+uint8_t OLED_Widget_Render(OLED_WidgetScreenTypeDef *pscreen);
+
+#ifdef __cplusplus
+}
+#endif  // C++ Support
+#endif  // OLEDWIDGET_H
@@ -0,0 +1,131 @@
+/**
+ * @Description 主机端基准程序共用的计时、总线列表与空传输，只在主机上编译，链接OLEDEmulator.c提供的OLED_Transmit
+ * @note 必须是基准程序包含的第一个头文件，否则-std=c99下clock_gettime没有声明
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+
+#ifndef OLED_BENCH_H
+#define OLED_BENCH_H
+#ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 199309L  // clock_gettime
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "OLEDDriver.h"
+#include "OLEDEmulator.h"
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  include <x86intrin.h>
+#  define OLED_BENCH_HAS_CYCLES 1
+#else
+#  define OLED_BENCH_HAS_CYCLES 0
+#endif
+
+#define OLED_BENCH_QUICK_DIVISOR 100  // 命令行参数--quick时迭代次数缩小的倍数，ctest只检查能否运行
+
+/**
+ * @brief 仿真的总线，依次为I2C 100k/400k/1M与SPI 8M
+ */
+typedef struct {
+  const char *name;        // 表头
+  OLED_EmuBusTypeDef bus;  // 总线类型
+  uint32_t clock;          // 总线时钟(Hz)
+} OLED_BenchBusTypeDef;
+
+#define OLED_BENCH_BUS_COUNT 4
+
+static const OLED_BenchBusTypeDef s_oled_bench_buses[OLED_BENCH_BUS_COUNT] = {
+    {"i2c100k", OLED_EMU_BUS_I2C, 100000},
+    {"i2c400k", OLED_EMU_BUS_I2C, 400000},
+    {"i2c1m", OLED_EMU_BUS_I2C, 1000000},
+    {"spi8m", OLED_EMU_BUS_SPI, 8000000},
+};
+
+/**
+ * 单调时钟
+ * @return 纳秒
+ */
+static inline uint64_t OLED_Bench_Now(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * 时间戳计数器，只在x86上可用
+ * @return CPU周期数(TSC为恒定频率时是参考周期)，不可用时返回0
+ */
+static inline uint64_t OLED_Bench_Cycles(void)
+{
+#if OLED_BENCH_HAS_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * 按命令行参数决定迭代次数
+ * @param argc 参数个数
+ * @param argv 参数
+ * @param iterations 正常测量的迭代次数
+ * @return 带--quick时缩小OLED_BENCH_QUICK_DIVISOR倍，至少为1
+ */
+static inline uint32_t OLED_Bench_Iterations(int argc, char **argv, uint32_t iterations)
+{
+  for (int i = 1; i < argc; ++i) {
+    if (0 == strcmp(argv[i], "--quick")) {
+      iterations /= OLED_BENCH_QUICK_DIVISOR;
+      break;
+    }
+  }
+  return 0 == iterations ? 1 : iterations;
+}
+
+/**
+ * 只丢弃数据的传输，测量CPU时间时代替仿真控制器，避免把命令流解析的耗时算进驱动
+ * @note 同步返回，不能用于OLED_USING_DMA_TRANSMIT
+ */
+static OLED_StatusTypeDef OLED_Bench_Sink_Transmit(OLED_HandleTypeDef *phandle, uint8_t *pData, uint16_t Size,
+                                                   uint8_t mode)
+{
+  (void)phandle;
+  (void)pData;
+  (void)Size;
+  (void)mode;
+  return OLED_OK;
+}
+
+static const OLED_TransportTypeDef s_oled_bench_sink = {.transmit = OLED_Bench_Sink_Transmit};
+
+/**
+ * 切换默认实例的传输函数
+ * @param sink 1为只丢弃数据，0为仿真控制器
+ */
+static inline void OLED_Bench_Use_Sink(uint8_t sink)
+{
+  g_oled_handle.ptransport = sink ? &s_oled_bench_sink : &g_oled_default_transport;
+}
+
+/**
+ * 设置仿真总线并清零统计
+ * @param index s_oled_bench_buses的下标
+ */
+static inline void OLED_Bench_Select_Bus(uint8_t index)
+{
+  OLED_Emu_Set_Bus(s_oled_bench_buses[index].bus, s_oled_bench_buses[index].clock);
+  OLED_Emu_Clear_Stats();
+}
+
+/**
+ * 打印各总线的表头
+ */
+static inline void OLED_Bench_Print_Bus_Header(void)
+{
+  for (uint8_t i = 0; i < OLED_BENCH_BUS_COUNT; ++i) printf(" %9s", s_oled_bench_buses[i].name);
+}
+
+#endif  // OLED_BENCH_H
@@ -0,0 +1,121 @@
+/**
+ * @Description 驱动基准: 整屏刷新、OLED_ShowStr、OLED_setPoint与填充，输出每次操作的CPU耗时与每帧的总线时间
+ *              static_frame与direct_3_bytes对比影子帧比较: 画面不变时的刷新，以及直接改写显存中3个字节后的刷新
+ * @note CPU耗时用只丢弃数据的传输测量，不含命令流解析；总线时间由仿真控制器按各总线时钟估算
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "bench.h"
+
+/**
+ * @brief 一个测量项
+ */
+typedef struct {
+  const char *name;         // 名称
+  void (*op)(uint32_t i);   // 一次操作，i为操作的序号
+  uint16_t ops_per_frame;   // 多少次操作组成一帧
+  uint8_t refresh;          // 一帧的操作之后还需要调用OLED_Refresh_GSRAM(操作本身不发送)
+} OLED_BenchCaseTypeDef;
+
+static uint8_t s_text_6x8[] = "Hello OLED 01234567";
+static uint8_t s_text_8x16[] = "OLED 8x16 Text";
+
+static void OLED_Bench_Refresh_Full(uint32_t i)
+{
+  (void)i;
+  OLED_MARK_ALL_DIRTY();
+  OLED_Refresh_GSRAM();
+}
+
+static void OLED_Bench_Show_Str_6x8(uint32_t i) { OLED_ShowStr(0, i % OLED_PAGE_SIZE, s_text_6x8, 1); }
+
+static void OLED_Bench_Show_Str_8x16(uint32_t i) { OLED_ShowStr(0, (i % (OLED_PAGE_SIZE / 2)) * 2, s_text_8x16, 2); }
+
+static void OLED_Bench_Set_Point(uint32_t i)
+{
+  OLED_setPoint(i % OLED_PIX_WIDTH, (i / 2) % OLED_PIX_HEIGHT, (i / OLED_PIX_WIDTH) & 1 ? 0 : 1);
+}
+
+static void OLED_Bench_Static_Frame(uint32_t i)
+{
+  (void)i;
+  OLED_Refresh_GSRAM();
+}
+
+/**
+ * 直接改写分散在三页中的3个字节再刷新，不经过绘图函数
+ * @note 只开启局部刷新时不知道改了哪里，只能标记整屏；开启影子帧后由比较找出改动
+ */
+static void OLED_Bench_Direct_3_Bytes(uint32_t i)
+{
+  uint8_t value = (i & 1) ? 0x00 : 0x5a;
+  g_oled_buffer[0][3] = value;
+  g_oled_buffer[3][64] = value;
+  g_oled_buffer[7][120] = value;
+#if defined(OLED_USING_PARTIAL_REFRESH) && !defined(OLED_USING_SHADOW_REFRESH)
+  OLED_MARK_ALL_DIRTY();
+#endif
+  OLED_Refresh_GSRAM();
+}
+
+static void OLED_Bench_Fill(uint32_t i) { OLED_Fill(i & 1); }
+
+static void OLED_Bench_Fill_Buffer(uint32_t i) { OLED_Fill_Buffer(i & 1); }
+
+static const OLED_BenchCaseTypeDef s_cases[] = {
+    {"refresh_full", OLED_Bench_Refresh_Full, 1, 0},
+    {"show_str_6x8", OLED_Bench_Show_Str_6x8, OLED_PAGE_SIZE, 1},
+    {"show_str_8x16", OLED_Bench_Show_Str_8x16, OLED_PAGE_SIZE / 2, 1},
+    {"set_point", OLED_Bench_Set_Point, OLED_PIX_WIDTH, 1},
+    {"fill", OLED_Bench_Fill, 1, 0},
+    {"fill_buffer", OLED_Bench_Fill_Buffer, 1, 1},
+    {"static_frame", OLED_Bench_Static_Frame, 1, 0},
+    {"direct_3_bytes", OLED_Bench_Direct_3_Bytes, 1, 0},
+};
+
+/**
+ * 清空显存与屏幕，作为每次测量的起点
+ */
+static void OLED_Bench_Reset(void)
+{
+  OLED_Fill_Buffer(0);
+  OLED_Refresh_GSRAM();
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t iterations = OLED_Bench_Iterations(argc, argv, 100000);
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+  printf("%-16s %9s %9s %9s", "case", "ns/op", "cyc/op", "B/frame");
+  OLED_Bench_Print_Bus_Header();
+  printf("  (us/frame)\n");
+  for (uint8_t c = 0; c < sizeof(s_cases) / sizeof(s_cases[0]); ++c) {
+    const OLED_BenchCaseTypeDef *pcase = &s_cases[c];
+    OLED_Bench_Use_Sink(1);
+    OLED_Bench_Reset();
+    uint64_t start = OLED_Bench_Now();
+    uint64_t cycles = OLED_Bench_Cycles();
+    for (uint32_t i = 0; i < iterations; ++i) pcase->op(i);
+    cycles = OLED_Bench_Cycles() - cycles;
+    double ns = (double)(OLED_Bench_Now() - start) / iterations;
+    OLED_Bench_Use_Sink(0);
+    printf("%-16s %9.1f", pcase->name, ns);
+    if (OLED_BENCH_HAS_CYCLES)
+      printf(" %9.0f", (double)cycles / iterations);
+    else
+      printf(" %9s", "-");
+    for (uint8_t b = 0; b < OLED_BENCH_BUS_COUNT; ++b) {
+      OLED_Bench_Reset();
+      OLED_Bench_Select_Bus(b);
+      for (uint32_t i = 0; i < pcase->ops_per_frame; ++i) pcase->op(i);
+      if (pcase->refresh) OLED_Refresh_GSRAM();
+      const OLED_EmuStatsTypeDef *pstats = &OLED_Emu_Get()->stats;
+      if (0 == b) printf(" %9u", (unsigned)(pstats->cmd_bytes + pstats->data_bytes));
+      printf(" %9.1f", pstats->wire_ns / 1000.0);
+    }
+    printf("\n");
+  }
+  return 0;
+}
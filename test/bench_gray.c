@@ -0,0 +1,92 @@
+/**
+ * @Description 灰度基准: 各总线下每次切换位面的传输时间与可达的灰度周期，以及每次OLED_Gray_Tick的CPU耗时
+ * @note 场景与README中灰度显示一节的表格相同: 128x16的灰色文字带加32x32的灰度图标，以及整屏中间灰度
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "bench.h"
+#include "OLEDGray.h"
+
+#define OLED_BENCH_GRAY_CYCLES 10  // 估算总线时间时运行的灰度周期数
+
+static uint8_t s_plane_low[OLED_PAGE_SIZE][OLED_PIX_WIDTH], s_plane_high[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+static OLED_GrayTypeDef s_gray;
+
+/**
+ * 文字带为1级灰度，图标为四级灰度的斜条纹
+ */
+static void OLED_Bench_Scene_Band_Icon(void)
+{
+  OLED_Gray_Fill_Rect(&s_gray, 0, 0, OLED_PIX_WIDTH, 16, 1);
+  for (int16_t y = 0; y < 32; ++y)
+    for (int16_t x = 0; x < 32; ++x) OLED_Gray_Set_Pixel(&s_gray, 48 + x, 24 + y, ((x + y) >> 2) & 3);
+}
+
+static void OLED_Bench_Scene_Full(void) { OLED_Gray_Fill_Rect(&s_gray, 0, 0, OLED_PIX_WIDTH, OLED_PIX_HEIGHT, 2); }
+
+/**
+ * @brief 一个场景
+ */
+typedef struct {
+  const char *name;    // 名称
+  void (*draw)(void);  // 在两个位面上绘制
+} OLED_BenchGrayTypeDef;
+
+static const OLED_BenchGrayTypeDef s_scenes[] = {
+    {"band_icon", OLED_Bench_Scene_Band_Icon},
+    {"full_screen", OLED_Bench_Scene_Full},
+};
+
+/**
+ * 从空白画面开始灰度显示并绘制场景，先跑一个灰度周期把画面发到屏幕上
+ */
+static void OLED_Bench_Gray_Start(const OLED_BenchGrayTypeDef *pscene)
+{
+  OLED_Fill_Buffer(0);
+  OLED_Refresh_GSRAM();
+  OLED_Gray_Init(&s_gray, &g_oled_handle, s_plane_low[0], s_plane_high[0]);
+  pscene->draw();
+  for (uint8_t i = 0; i < OLED_GRAY_PHASES; ++i) OLED_Gray_Tick(&s_gray);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t iterations = OLED_Bench_Iterations(argc, argv, 300000);
+  int result = 0;
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+  printf("%-12s %9s %9s", "scene", "ns/tick", "B/switch");
+  for (uint8_t b = 0; b < OLED_BENCH_BUS_COUNT; ++b) printf(" %11s", s_oled_bench_buses[b].name);
+  printf("  (ms/switch / cycles/s)\n");
+  for (uint8_t s = 0; s < sizeof(s_scenes) / sizeof(s_scenes[0]); ++s) {
+    const OLED_BenchGrayTypeDef *pscene = &s_scenes[s];
+    OLED_Bench_Use_Sink(1);
+    OLED_Bench_Gray_Start(pscene);
+    uint64_t start = OLED_Bench_Now();
+    for (uint32_t i = 0; i < iterations; ++i) OLED_Gray_Tick(&s_gray);
+    double ns = (double)(OLED_Bench_Now() - start) / iterations;
+    OLED_Gray_Deinit(&s_gray);
+    OLED_Bench_Use_Sink(0);
+    printf("%-12s %9.1f", pscene->name, ns);
+
+    for (uint8_t b = 0; b < OLED_BENCH_BUS_COUNT; ++b) {
+      OLED_Bench_Gray_Start(pscene);
+      OLED_Bench_Select_Bus(b);
+      s_gray.stats.switches = 0;
+      for (uint32_t i = 0; i < OLED_BENCH_GRAY_CYCLES * OLED_GRAY_PHASES; ++i) OLED_Gray_Tick(&s_gray);
+      OLED_Gray_Deinit(&s_gray);
+      const OLED_EmuStatsTypeDef *pstats = &OLED_Emu_Get()->stats;
+      if (0 == s_gray.stats.switches) {
+        result = 1;
+        break;
+      }
+      double switch_ns = (double)pstats->wire_ns / s_gray.stats.switches;
+      if (0 == b) printf(" %9u", (unsigned)((pstats->cmd_bytes + pstats->data_bytes) / s_gray.stats.switches));
+      // 一个灰度周期切换两次位面
+      printf(" %6.2f/%-4.0f", switch_ns / 1e6, 1e9 / (switch_ns * (OLED_GRAY_PHASES - 1)));
+    }
+    printf("\n");
+  }
+  return result;
+}
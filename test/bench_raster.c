@@ -0,0 +1,154 @@
+/**
+ * @Description 光栅基准: OLEDGraphics.h中的按页绘制与逐点调用OLED_setPoint画出同样图形的CPU耗时对比
+ * @note 两种方式画出的显存逐字节比较，不同时返回1；只写显存，不刷新
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "bench.h"
+#include "OLEDGraphics.h"
+
+/**
+ * @brief 一个测量项，fast为OLEDGraphics.h中的函数，slow为逐点的等价实现
+ */
+typedef struct {
+  const char *name;    // 名称
+  void (*fast)(void);  // 按页绘制
+  void (*slow)(void);  // 逐点调用OLED_setPoint
+} OLED_BenchRasterTypeDef;
+
+static void OLED_Bench_HLine_Fast(void) { OLED_Draw_HLine(0, 13, OLED_PIX_WIDTH, 1); }
+
+static void OLED_Bench_HLine_Slow(void)
+{
+  for (uint8_t x = 0; x < OLED_PIX_WIDTH; ++x) OLED_setPoint(x, 13, 1);
+}
+
+static void OLED_Bench_VLine_Fast(void) { OLED_Draw_VLine(77, 0, OLED_PIX_HEIGHT, 1); }
+
+static void OLED_Bench_VLine_Slow(void)
+{
+  for (uint8_t y = 0; y < OLED_PIX_HEIGHT; ++y) OLED_setPoint(77, y, 1);
+}
+
+static void OLED_Bench_Fill_Rect_Fast(void) { OLED_Fill_Rect(10, 5, 100, 50, 1); }
+
+static void OLED_Bench_Fill_Rect_Slow(void)
+{
+  for (uint8_t y = 5; y < 55; ++y)
+    for (uint8_t x = 10; x < 110; ++x) OLED_setPoint(x, y, 1);
+}
+
+static void OLED_Bench_Line_Fast(void) { OLED_Draw_Line(3, 60, 124, 2, 1); }
+
+/**
+ * 与OLED_Draw_Line相同的取点规则: 沿主轴第i步的副轴偏移为round(i * dn / dm)
+ */
+static void OLED_Bench_Line_Slow(void)
+{
+  const int32_t x0 = 3, y0 = 60, dm = 124 - 3, dn = 60 - 2;
+  for (int32_t i = 0; i <= dm; ++i) OLED_setPoint(x0 + i, y0 - (2 * i * dn + dm) / (2 * dm), 1);
+}
+
+static void OLED_Bench_Circle_Fast(void) { OLED_Draw_Circle(64, 32, 30, 1); }
+
+/**
+ * 中点画圆，每一步对称地画8个点
+ */
+static void OLED_Bench_Circle_Slow(void)
+{
+  const int16_t xc = 64, yc = 32;
+  int16_t x = 30, y = 0, err = 1 - 30;
+  while (x >= y) {
+    OLED_setPoint(xc + x, yc + y, 1);
+    OLED_setPoint(xc - x, yc + y, 1);
+    OLED_setPoint(xc + x, yc - y, 1);
+    OLED_setPoint(xc - x, yc - y, 1);
+    OLED_setPoint(xc + y, yc + x, 1);
+    OLED_setPoint(xc - y, yc + x, 1);
+    OLED_setPoint(xc + y, yc - x, 1);
+    OLED_setPoint(xc - y, yc - x, 1);
+    y++;
+    if (err < 0) {
+      err += 2 * y + 1;
+    } else {
+      x--;
+      err += 2 * (y - x) + 1;
+    }
+  }
+}
+
+static void OLED_Bench_Fill_Circle_Fast(void) { OLED_Fill_Circle(64, 32, 30, 1); }
+
+/**
+ * 逐点画出中点画圆每一步上下对称的四条水平线
+ */
+static void OLED_Bench_Span_Slow(int16_t x, int16_t y, int16_t width)
+{
+  for (int16_t i = 0; i < width; ++i) OLED_setPoint(x + i, y, 1);
+}
+
+static void OLED_Bench_Fill_Circle_Slow(void)
+{
+  const int16_t xc = 64, yc = 32;
+  int16_t x = 30, y = 0, err = 1 - 30;
+  while (x >= y) {
+    OLED_Bench_Span_Slow(xc - x, yc + y, 2 * x + 1);
+    OLED_Bench_Span_Slow(xc - x, yc - y, 2 * x + 1);
+    OLED_Bench_Span_Slow(xc - y, yc + x, 2 * y + 1);
+    OLED_Bench_Span_Slow(xc - y, yc - x, 2 * y + 1);
+    y++;
+    if (err < 0) {
+      err += 2 * y + 1;
+    } else {
+      x--;
+      err += 2 * (y - x) + 1;
+    }
+  }
+}
+
+static const OLED_BenchRasterTypeDef s_cases[] = {
+    {"hline_128", OLED_Bench_HLine_Fast, OLED_Bench_HLine_Slow},
+    {"vline_64", OLED_Bench_VLine_Fast, OLED_Bench_VLine_Slow},
+    {"fill_rect_100x50", OLED_Bench_Fill_Rect_Fast, OLED_Bench_Fill_Rect_Slow},
+    {"line_121x58", OLED_Bench_Line_Fast, OLED_Bench_Line_Slow},
+    {"circle_r30", OLED_Bench_Circle_Fast, OLED_Bench_Circle_Slow},
+    {"fill_circle_r30", OLED_Bench_Fill_Circle_Fast, OLED_Bench_Fill_Circle_Slow},
+};
+
+/**
+ * 重复调用一个绘制函数
+ * @return 每次调用的纳秒数
+ */
+static double OLED_Bench_Time(void (*draw)(void), uint32_t iterations)
+{
+  OLED_Fill_Buffer(0);
+  uint64_t start = OLED_Bench_Now();
+  for (uint32_t i = 0; i < iterations; ++i) draw();
+  return (double)(OLED_Bench_Now() - start) / iterations;
+}
+
+int main(int argc, char **argv)
+{
+  static uint8_t s_expected[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+  uint32_t iterations = OLED_Bench_Iterations(argc, argv, 100000);
+  int result = 0;
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+  printf("%-18s %10s %10s %8s %s\n", "case", "raster ns", "point ns", "speedup", "same");
+  for (uint8_t c = 0; c < sizeof(s_cases) / sizeof(s_cases[0]); ++c) {
+    const OLED_BenchRasterTypeDef *pcase = &s_cases[c];
+    OLED_Fill_Buffer(0);
+    pcase->slow();
+    memcpy(s_expected, g_oled_buffer, sizeof(s_expected));
+    OLED_Fill_Buffer(0);
+    pcase->fast();
+    uint8_t same = 0 == memcmp(s_expected, g_oled_buffer, sizeof(s_expected));
+    if (!same) result = 1;
+
+    double fast = OLED_Bench_Time(pcase->fast, iterations);
+    double slow = OLED_Bench_Time(pcase->slow, iterations);
+    printf("%-18s %10.1f %10.1f %7.1fx %s\n", pcase->name, fast, slow, slow / fast, same ? "yes" : "NO");
+  }
+  return result;
+}
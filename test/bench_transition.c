@@ -0,0 +1,107 @@
+/**
+ * @Description 转场基准: 每种效果每秒能合成的步数，以及每步的总线字节数和各总线下每秒能发出的步数
+ * @note 场景与README中转场动画一节的表格相同；每种效果走完之后检查显存和仿真屏幕上都是新画面，不同时返回1
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include "bench.h"
+#include "OLEDFont.h"
+#include "OLEDGraphics.h"
+#include "OLEDTransition.h"
+
+#define OLED_BENCH_TRANSITION_STRIDE 4  // 估算总线时间时进度每步前进的量，共64步
+
+static uint8_t s_source[OLED_PAGE_SIZE][OLED_PIX_WIDTH], s_target[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+
+static const char *const s_effect_names[] = {"slide_left", "slide_right", "slide_up",  "slide_down", "wipe_left",
+                                             "wipe_right", "wipe_up",     "wipe_down", "dissolve",   "flip"};
+
+/**
+ * 旧画面为伪随机的字节，新画面为矩形、圆和一行文字
+ */
+static void OLED_Bench_Make_Frames(void)
+{
+  OLED_HandleTypeDef target = g_oled_handle;
+  target.pbuffer = s_target[0];
+  for (uint8_t page = 0; page < OLED_PAGE_SIZE; ++page)
+    for (uint8_t x = 0; x < OLED_PIX_WIDTH; ++x) {
+      uint16_t i = page * OLED_PIX_WIDTH + x;
+      s_source[page][x] = (uint8_t)(i * 37 + page * 11);
+    }
+  OLEDH_Fill_Rect(&target, 10, 5, 40, 30, 1);
+  OLEDH_Draw_Circle(&target, 90, 32, 25, 1);
+  OLEDH_Draw_Text(&target, 20, 40, &g_oled_font_8x16, "Target", OLED_ROP_XOR);
+}
+
+/**
+ * 把旧画面发到屏幕上，作为一次转场的起点
+ */
+static void OLED_Bench_Show_Source(void)
+{
+  memcpy(g_oled_buffer, s_source, sizeof(s_source));
+  OLED_MARK_ALL_DIRTY();
+  OLED_Refresh_GSRAM();
+}
+
+/**
+ * 检查显存与仿真屏幕上都是新画面
+ * @return 相同时返回1
+ */
+static uint8_t OLED_Bench_Shows_Target(void)
+{
+  if (0 != memcmp(g_oled_buffer, s_target, sizeof(s_target))) return 0;
+  for (uint8_t y = 0; y < OLED_PIX_HEIGHT; ++y)
+    for (uint8_t x = 0; x < OLED_PIX_WIDTH; ++x)
+      if (OLED_Emu_Get_Pixel(x, y) != ((s_target[y >> 3][x] >> (y & 7)) & 1)) return 0;
+  return 1;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t passes = OLED_Bench_Iterations(argc, argv, 200);
+  int result = 0;
+  OLED_TransitionTypeDef trans;
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+  OLED_Bench_Make_Frames();
+  printf("%-12s %10s %8s", "effect", "steps/s", "B/step");
+  OLED_Bench_Print_Bus_Header();
+  printf("  (steps/s)\n");
+  for (uint8_t e = OLED_TRANSITION_SLIDE_LEFT; e <= OLED_TRANSITION_FLIP; ++e) {
+    // 合成只计CPU时间，每一遍都从头走完256级进度，只统计改变了显存的步
+    uint32_t steps = 0;
+    uint64_t start = OLED_Bench_Now();
+    for (uint32_t pass = 0; pass < passes; ++pass) {
+      OLED_Transition_Init(&trans, NULL, NULL);
+      OLED_Transition_Start(&trans, s_source[0], s_target[0], e, OLED_EASE_LINEAR, 0, 0);
+      for (uint16_t t = 0; t <= 255; ++t) steps += OLED_Transition_Render(&trans, (uint8_t)t);
+    }
+    double seconds = (double)(OLED_Bench_Now() - start) / 1e9;
+    printf("%-12s %10.0f", s_effect_names[e], steps / seconds);
+
+    for (uint8_t b = 0; b < OLED_BENCH_BUS_COUNT; ++b) {
+      OLED_Bench_Show_Source();
+      OLED_Bench_Select_Bus(b);
+      OLED_Transition_Init(&trans, NULL, NULL);
+      OLED_Transition_Start(&trans, s_source[0], s_target[0], e, OLED_EASE_LINEAR, 0, 0);
+      uint32_t sent = 0;
+      for (uint16_t t = 0; t <= 255; t += OLED_BENCH_TRANSITION_STRIDE) {
+        if (!OLED_Transition_Render(&trans, (uint8_t)t)) continue;
+        OLED_Refresh_GSRAM();
+        sent++;
+      }
+      if (OLED_Transition_Render(&trans, 255)) {
+        OLED_Refresh_GSRAM();
+        sent++;
+      }
+      if (!OLED_Bench_Shows_Target() || 0 == sent) result = 1;
+      const OLED_EmuStatsTypeDef *pstats = &OLED_Emu_Get()->stats;
+      if (0 == b) printf(" %8u", (unsigned)(pstats->data_bytes / sent));
+      printf(" %9.0f", 1e9 * sent / pstats->wire_ns);
+    }
+    printf("\n");
+  }
+  if (result) printf("final frame differs from the target\n");
+  return result;
+}
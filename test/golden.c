@@ -0,0 +1,163 @@
+/**
+ * @Description 基准图像测试: 按固定的场景绘制并刷新，把仿真屏幕上实际显示的画面与golden目录下的PBM逐点比较
+ * @note 用法: golden <基准图像目录> [--update]，带--update时用当前配置重新生成基准图像
+ * @note 所有优化选项(页寻址、局部刷新、影子帧、DMA、分段传输、硬件滚动)都应该与不带选项的配置显示相同的画面
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include <stdio.h>
+#include <string.h>
+#include "OLEDDriver.h"
+#include "OLEDEmulator.h"
+#include "OLEDFont.h"
+#include "OLEDGraphics.h"
+
+#define OLED_GOLDEN_PATH_LENGTH 512
+
+#ifdef OLED_USING_DMA_TRANSMIT
+/**
+ * 等待异步刷新时由仿真控制器完成一段传输
+ */
+void OLED_Wait_Refresh_Idle(void) { OLED_Emu_Complete(); }
+#  define OLED_GOLDEN_WAIT() OLED_Wait_Refresh()
+#else
+#  define OLED_GOLDEN_WAIT()
+#endif
+
+static uint8_t s_pbm[OLED_EMU_PBM_SIZE(OLED_PIX_WIDTH, OLED_PIX_HEIGHT)];
+static uint8_t s_golden[OLED_EMU_PBM_SIZE(OLED_PIX_WIDTH, OLED_PIX_HEIGHT)];
+static const char *s_dir;
+static uint8_t s_update;
+
+static void OLED_Golden_Refresh(void)
+{
+  OLED_Refresh_GSRAM();
+  OLED_GOLDEN_WAIT();
+}
+
+/**
+ * 与基准图像比较，--update时改为写入
+ * @param name 场景名，对应<目录>/<name>.pbm
+ * @return 相同或写入成功时返回0
+ */
+static int OLED_Golden_Check(const char *name)
+{
+  char path[OLED_GOLDEN_PATH_LENGTH];
+  snprintf(path, sizeof(path), "%s/%s.pbm", s_dir, name);
+  uint32_t length = OLED_Emu_Export_PBM(OLED_Emu_Get(), s_pbm, sizeof(s_pbm));
+  if (s_update) {
+    FILE *pfile = fopen(path, "wb");
+    if (NULL == pfile || length != fwrite(s_pbm, 1, length, pfile)) {
+      printf("%s: cannot write\n", path);
+      if (pfile) fclose(pfile);
+      return 1;
+    }
+    fclose(pfile);
+    printf("%s: written\n", path);
+    return 0;
+  }
+  FILE *pfile = fopen(path, "rb");
+  if (NULL == pfile) {
+    printf("%s: missing, run with --update to create it\n", path);
+    return 1;
+  }
+  size_t size = fread(s_golden, 1, sizeof(s_golden), pfile);
+  fclose(pfile);
+  int32_t diff = OLED_Emu_Compare_PBM(OLED_Emu_Get(), s_golden, (uint32_t)size);
+  if (0 == diff) return 0;
+  printf("%s: %d pixels differ\n", name, (int)diff);
+  return 1;
+}
+
+/**
+ * 每页一行文字"line n"
+ * @param first 第一行的编号
+ * @param y 第一行的纵坐标，可以为负
+ */
+static void OLED_Golden_Draw_Lines(uint8_t first, int16_t y)
+{
+  char line[8];
+  for (uint8_t i = 0; i < OLED_PAGE_SIZE; ++i) {
+    snprintf(line, sizeof(line), "line %u", (unsigned)(first + i));
+    OLED_Draw_Text(0, y + i * 8, &g_oled_font_6x8, line, OLED_ROP_COPY);
+  }
+}
+
+/**
+ * 滚动三次整行再滚动3行，不开启硬件滚动时直接在显存中画出相同的结果
+ */
+static void OLED_Golden_Scroll(void)
+{
+  OLED_Fill_Buffer(0);
+  OLED_Golden_Draw_Lines(0, 0);
+  OLED_Golden_Refresh();
+#ifdef OLED_USING_HARDWARE_SCROLL
+  char line[8];
+  for (uint8_t i = 0; i < 3; ++i) {
+    OLED_Scroll(8);
+    snprintf(line, sizeof(line), "line %u", (unsigned)(OLED_PAGE_SIZE + i));
+    OLED_Draw_Text(0, OLED_PIX_HEIGHT - 8, &g_oled_font_6x8, line, OLED_ROP_COPY);
+    OLED_Golden_Refresh();
+  }
+  OLED_Scroll(3);
+#else
+  for (uint8_t i = 1; i <= 3; ++i) {
+    OLED_Fill_Buffer(0);
+    OLED_Golden_Draw_Lines(i, 0);
+    OLED_Golden_Refresh();
+  }
+  OLED_Fill_Buffer(0);
+  OLED_Golden_Draw_Lines(3, -3);
+#endif
+  OLED_Golden_Refresh();
+}
+
+int main(int argc, char **argv)
+{
+  int result = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (0 == strcmp(argv[i], "--update"))
+      s_update = 1;
+    else
+      s_dir = argv[i];
+  }
+  if (NULL == s_dir) {
+    printf("usage: %s <golden dir> [--update]\n", argv[0]);
+    return 2;
+  }
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+
+  OLED_Fill(0);
+  OLED_GOLDEN_WAIT();
+  result |= OLED_Golden_Check("blank");
+
+  OLED_ShowStr(0, 0, (uint8_t *)"Hello", 1);
+  OLED_ShowStr(0, 2, (uint8_t *)"OLED 8x16", 2);
+  for (uint8_t i = 0; i < 60; ++i) OLED_setPoint(64 + i, i, 1);
+  OLED_Draw_Chinese(0, 36, 0, OLED_ROP_COPY);
+  OLED_Draw_Chinese(16, 36, 0xff, OLED_ROP_COPY);  // 超出字库，缺字方框
+  OLED_Golden_Refresh();
+  result |= OLED_Golden_Check("text");
+
+  // 纵坐标不按页对齐的异或文字跨两页
+  OLED_Draw_Circle(100, 40, 20, 1);
+  OLED_Fill_Rect(3, 50, 30, 10, 1);
+  OLED_Draw_Text(37, 27, &g_oled_font_6x8, "shifted", OLED_ROP_XOR);
+  OLED_Golden_Refresh();
+  result |= OLED_Golden_Check("shapes");
+
+  OLED_setPoint(64 + 5, 5, 0);
+  OLED_setPoint(OLED_PIX_WIDTH - 1, OLED_PIX_HEIGHT - 1, 1);
+  OLED_Golden_Refresh();
+  result |= OLED_Golden_Check("points");
+
+  OLED_Fill(1);
+  OLED_GOLDEN_WAIT();
+  result |= OLED_Golden_Check("fill");
+
+  OLED_Golden_Scroll();
+  result |= OLED_Golden_Check("scroll");
+  return result;
+}
@@ -0,0 +1,74 @@
+/**
+ * @Description 连续水平滚动测试: 仿真控制器按收到的滚动区域移动GDDRAM，屏幕上的画面应在可见的列之内循环移动
+ * @note 屏幕比GDDRAM窄、有列偏移或者旋转180度时，SSD1309的列范围必须正好是屏幕接着的那些GDDRAM列
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#include <stdio.h>
+#include <string.h>
+#include "OLEDDriver.h"
+#include "OLEDEmulator.h"
+#include "OLEDFont.h"
+
+#define OLED_HSCROLL_STEPS 5  // 每个方向滚动的列数
+
+static uint8_t s_before[OLED_PIX_HEIGHT][OLED_PIX_WIDTH];
+
+/**
+ * 滚动一个方向并检查画面
+ * @param left 1->向左;0->向右，方向按屏幕上看到的
+ * @return 画面正确时返回0
+ */
+static int OLED_HScroll_Check(uint8_t left)
+{
+  const uint8_t page_start = 1, page_end = OLED_PAGE_SIZE - 2;
+  for (uint8_t y = 0; y < OLED_PIX_HEIGHT; ++y)
+    for (uint8_t x = 0; x < OLED_PIX_WIDTH; ++x) s_before[y][x] = OLED_Emu_Get_Pixel(x, y);
+  // 旋转180度后段重映射反过来，GDDRAM中向左移动在屏幕上是向右
+  uint8_t ram_left = OLED_ROTATION == 180 ? !left : left;
+  if (OLED_OK != OLED_Scroll_Horizontal_Start(ram_left, page_start, page_end, 0)) {
+    printf("scroll start failed\n");
+    return 1;
+  }
+  for (uint8_t i = 0; i < OLED_HSCROLL_STEPS; ++i) OLED_Emu_Scroll_Step(&g_oled_emu);
+  OLED_Scroll_Horizontal_Stop();
+
+  // 旋转后显存第page页显示在屏幕的另一端
+  uint8_t row_start = OLED_ROTATION == 180 ? OLED_PIX_HEIGHT - (page_end + 1) * 8 : page_start * 8;
+  uint8_t row_end = row_start + (page_end - page_start + 1) * 8;
+  uint32_t diff = 0;
+  for (uint8_t y = 0; y < OLED_PIX_HEIGHT; ++y) {
+    for (uint8_t x = 0; x < OLED_PIX_WIDTH; ++x) {
+      uint8_t source = x;
+      if (y >= row_start && y < row_end)
+        source = left ? (x + OLED_HSCROLL_STEPS) % OLED_PIX_WIDTH
+                      : (x + OLED_PIX_WIDTH - OLED_HSCROLL_STEPS) % OLED_PIX_WIDTH;
+      diff += OLED_Emu_Get_Pixel(x, y) != s_before[y][source];
+    }
+  }
+  if (0 == diff) return 0;
+  printf("scroll %s: %u pixels differ\n", left ? "left" : "right", (unsigned)diff);
+  return 1;
+}
+
+int main(void)
+{
+  int result = 0;
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+  // 两端各一条竖线，滚到不可见的列上时会从画面中消失
+  for (uint8_t page = 0; page < OLED_PAGE_SIZE; ++page) {
+    g_oled_buffer[page][0] = 0xff;
+    g_oled_buffer[page][OLED_PIX_WIDTH - 1] = 0x3c;
+  }
+  OLED_MARK_ALL_DIRTY();
+  OLED_Draw_Text(3, 9, &g_oled_font_6x8, "Scroll", OLED_ROP_COPY);
+  OLED_Draw_Text(10, 20, &g_oled_font_8x16, "0123", OLED_ROP_COPY);
+  OLED_Refresh_GSRAM();
+
+  result |= OLED_HScroll_Check(1);
+  OLED_Refresh_GSRAM();  // 停止滚动后整屏重新发送
+  result |= OLED_HScroll_Check(0);
+  return result;
+}
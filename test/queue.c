@@ -0,0 +1,173 @@
+/**
+ * @Description 渲染队列测试，用OLED_OS_POSIX的pthread信号量在主机上运行:
+ *              多个生产者线程并发投递，每条命令只执行一次，队列已满的次数与overflows一致；
+ *              一轮里的多次刷新请求只刷新一次；生产者还没写完的一格会让显示任务停下，写完后继续
+ * @Author jinming xi
+ * @Date 2022/11/6
+ * @Project OLEDDriver
+ */
+#ifndef _POSIX_C_SOURCE
+#  define _POSIX_C_SOURCE 200112L  // sched_yield
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include "OLEDEmulator.h"
+#include "OLEDGraphics.h"
+#include "OLEDQueue.h"
+
+#define OLED_QUEUE_TEST_PRODUCERS 4      // 生产者线程数
+#define OLED_QUEUE_TEST_POSTS 20000      // 每个生产者投递的命令数
+#define OLED_QUEUE_TEST_REFRESH_EVERY 8  // 每投递几条命令请求一次刷新
+#define OLED_QUEUE_TEST_COALESCE 5       // 同一轮里的刷新请求数
+
+#ifdef OLED_USING_DMA_TRANSMIT
+void OLED_Wait_Refresh_Idle(void) { OLED_Emu_Complete(); }
+#  define OLED_QUEUE_TEST_FINISH() while (OLED_Emu_Complete())
+#else
+#  define OLED_QUEUE_TEST_FINISH()
+#endif
+
+static OLED_QueueTypeDef s_queue;
+static uint8_t s_executed[OLED_QUEUE_TEST_PRODUCERS][OLED_QUEUE_TEST_POSTS];  // 每条命令被执行的次数
+static uint32_t s_busy;     // 生产者收到OLED_BUSY的次数
+static uint32_t s_stopped;  // 生产者都已结束
+
+/**
+ * 在显示任务中执行，记录这条命令执行过一次
+ */
+static void OLED_Queue_Test_Mark(OLED_HandleTypeDef *phandle, void *parg)
+{
+  (void)phandle;
+  uintptr_t id = (uintptr_t)parg;
+  s_executed[id / OLED_QUEUE_TEST_POSTS][id % OLED_QUEUE_TEST_POSTS]++;
+}
+
+/**
+ * 队列已满时让出CPU重试，并记录收到OLED_BUSY的次数
+ */
+#define OLED_QUEUE_TEST_RETRY(post)                         \
+  while (OLED_OK != (post)) {                               \
+    __atomic_fetch_add(&s_busy, 1, __ATOMIC_RELAXED);       \
+    sched_yield();                                          \
+  }
+
+static void *OLED_Queue_Test_Producer(void *parg)
+{
+  uintptr_t producer = (uintptr_t)parg;
+  for (uint32_t i = 0; i < OLED_QUEUE_TEST_POSTS; ++i) {
+    uintptr_t id = producer * OLED_QUEUE_TEST_POSTS + i;
+    OLED_QUEUE_TEST_RETRY(OLED_Queue_Call(&s_queue, OLED_Queue_Test_Mark, (void *)id));
+    if (0 == i % OLED_QUEUE_TEST_REFRESH_EVERY) {
+      OLED_QUEUE_TEST_RETRY(OLED_Queue_Fill_Rect(&s_queue, producer * 32, (i / 8 % 8) * 8, 32, 8, i & 1));
+      OLED_QUEUE_TEST_RETRY(OLED_Queue_Refresh(&s_queue));
+    }
+  }
+  return NULL;
+}
+
+static void *OLED_Queue_Test_Display(void *parg)
+{
+  (void)parg;
+  while (!__atomic_load_n(&s_stopped, __ATOMIC_ACQUIRE) || s_queue.head != OLED_OS_ATOMIC_LOAD(&s_queue.tail))
+    OLED_Queue_Process(&s_queue, 5);
+  return NULL;
+}
+
+/**
+ * 多个生产者与一个显示任务并发
+ * @return 通过时返回0
+ */
+static int OLED_Queue_Test_Producers(void)
+{
+  pthread_t producers[OLED_QUEUE_TEST_PRODUCERS], display;
+  pthread_create(&display, NULL, OLED_Queue_Test_Display, NULL);
+  for (uintptr_t i = 0; i < OLED_QUEUE_TEST_PRODUCERS; ++i)
+    pthread_create(&producers[i], NULL, OLED_Queue_Test_Producer, (void *)i);
+  for (uint8_t i = 0; i < OLED_QUEUE_TEST_PRODUCERS; ++i) pthread_join(producers[i], NULL);
+  __atomic_store_n(&s_stopped, 1, __ATOMIC_RELEASE);
+  pthread_join(display, NULL);
+  OLED_QUEUE_TEST_FINISH();
+
+  uint32_t wrong = 0;
+  for (uint8_t p = 0; p < OLED_QUEUE_TEST_PRODUCERS; ++p)
+    for (uint32_t i = 0; i < OLED_QUEUE_TEST_POSTS; ++i) wrong += 1 != s_executed[p][i];
+  uint32_t differ = 0;
+  for (uint8_t y = 0; y < OLED_PIX_HEIGHT; ++y)
+    for (uint8_t x = 0; x < OLED_PIX_WIDTH; ++x)
+      differ += OLED_Emu_Get_Pixel(x, y) != ((g_oled_buffer[y >> 3][x] >> (y & 7)) & 1);
+  printf("producers: %u commands not run exactly once, %u busy, %u overflows, %u pixels differ\n", (unsigned)wrong,
+         (unsigned)s_busy, (unsigned)s_queue.overflows, (unsigned)differ);
+  return 0 != wrong || s_busy != s_queue.overflows || 0 != differ;
+}
+
+/**
+ * 一轮里的多次刷新请求只刷新一次，新增的绘制命令与直接调用绘图函数的结果相同
+ * @return 通过时返回0
+ */
+static int OLED_Queue_Test_Coalesce(void)
+{
+  static uint8_t s_expected[OLED_PAGE_SIZE][OLED_PIX_WIDTH];
+  OLED_Fill_Buffer(0);
+  OLED_Draw_Rect(3, 4, 50, 30, 1);
+  OLED_Draw_Circle(90, 30, 20, 1);
+  OLED_Fill_Circle(30, 45, 10, 1);
+  memcpy(s_expected, g_oled_buffer, sizeof(s_expected));
+
+  OLED_Queue_Fill(&s_queue, 0);
+  for (uint8_t i = 0; i < OLED_QUEUE_TEST_COALESCE; ++i) {
+    if (0 == i) OLED_Queue_Draw_Rect(&s_queue, 3, 4, 50, 30, 1);
+    if (1 == i) OLED_Queue_Draw_Circle(&s_queue, 90, 30, 20, 1);
+    if (2 == i) OLED_Queue_Fill_Circle(&s_queue, 30, 45, 10, 1);
+    OLED_Queue_Refresh(&s_queue);
+  }
+  OLED_Emu_Clear_Stats();
+  OLED_Queue_Process(&s_queue, 0);
+  OLED_QUEUE_TEST_FINISH();
+  uint32_t bytes = OLED_Emu_Get()->stats.data_bytes;
+  uint8_t same = 0 == memcmp(s_expected, g_oled_buffer, sizeof(s_expected));
+  printf("coalesce: %u refresh requests sent %u bytes, drawing %s\n", OLED_QUEUE_TEST_COALESCE, (unsigned)bytes,
+         same ? "matches" : "differs");
+  // 先填充了整个显存，刷新一次正好是一整帧
+  return !same || OLED_PAGE_SIZE * OLED_PIX_WIDTH != bytes;
+}
+
+/**
+ * 模拟一个生产者占到一格后被打断: 显示任务停在这一格上，之后的刷新请求等它写完后才执行
+ * @return 通过时返回0
+ */
+static int OLED_Queue_Test_Stalled(void)
+{
+  OLED_QueueCmdTypeDef fill = {.op = OLED_QUEUE_FILL, .state = 1};
+  uint32_t pos = OLED_OS_ATOMIC_LOAD(&s_queue.tail);
+  OLED_OS_ATOMIC_STORE(&s_queue.tail, pos + 1);  // 占到这一格但还没有写入
+  OLED_Queue_Refresh(&s_queue);
+
+  OLED_Emu_Clear_Stats();
+  OLED_Queue_Process(&s_queue, 0);
+  OLED_QUEUE_TEST_FINISH();
+  int result = !s_queue.stalled || 0 != OLED_Emu_Get()->stats.data_bytes;
+
+  OLED_QueueSlotTypeDef *pslot = &s_queue.slots[pos & (OLED_QUEUE_LENGTH - 1)];
+  pslot->cmd = fill;
+  OLED_OS_ATOMIC_STORE(&pslot->sequence, pos + 1);  // 生产者写完
+  OLED_Queue_Process(&s_queue, 0);
+  OLED_QUEUE_TEST_FINISH();
+  result |= s_queue.stalled || OLED_PAGE_SIZE * OLED_PIX_WIDTH != OLED_Emu_Get()->stats.data_bytes ||
+            1 != OLED_Emu_Get_Pixel(0, 0);
+  printf("stalled: %s\n", result ? "wrong" : "waits for the unfinished slot");
+  return result;
+}
+
+int main(void)
+{
+  int result = 0;
+  OLED_Emu_Reset();
+  if (OLED_OK != OLED_Init()) return 1;
+  if (OLED_OK != OLED_Queue_Init(&s_queue, &g_oled_handle)) return 1;
+  result |= OLED_Queue_Test_Producers();
+  result |= OLED_Queue_Test_Coalesce();
+  result |= OLED_Queue_Test_Stalled();
+  return result;
+}
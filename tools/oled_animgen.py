@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""
+OLEDDriver图像/动画压缩工具
+
+把一组单色帧转换成OLEDAnim.h中的OLED_AnimTypeDef:
+  - 每帧按页存储(每字节一列8个点，低位在上)，与OLED_Draw_Bitmap的格式相同
+  - 关键帧用游程编码，差分帧只编码与上一帧不同的字节，相同的字节跳过
+  - 播放到最后一帧后回到第0帧，第0帧总是关键帧
+  - 所有数据都是const，放在Flash中，解码时顺序读取
+
+帧数据的格式见OLEDAnim.h: 每帧一个标志字节，之后是覆盖整帧的记号
+  0x00~0x3f 跳过n个字节     0x40~0x7f 后跟1个字节，重复n次
+  0x80~0xbf 后跟n个原样字节  0xc0~0xff 后跟1个字节，跳过((低6位 << 8 | 该字节) + 1)个字节
+
+用法:
+  python3 oled_animgen.py logo.pbm --name anim_logo -o anim_logo.c
+  python3 oled_animgen.py frame*.pbm --name anim_walk --key-interval 16 -o anim_walk.c
+  python3 oled_animgen.py spinner.gif --name anim_spinner -o anim_spinner.c
+  python3 oled_animgen.py --raw 128x64 frames.bin --name anim_raw -o anim_raw.c
+"""
+
+import argparse
+import os
+import sys
+
+KEY_FRAME = 0x01
+SKIP, RUN, LITERAL, LONG_SKIP = 0x00, 0x40, 0x80, 0xC0
+MAX_SHORT = 64       # 短记号一次最多覆盖的字节数
+MAX_LONG = 1 << 14   # 长跳过一次最多覆盖的字节数
+MIN_RUN = 3          # 连续相同的字节至少这么多才单独编码成重复
+
+
+def read_pbm(path):
+    """读取P1/P4格式的PBM，返回rows[y][x]为0/1"""
+    with open(path, "rb") as f:
+        data = f.read()
+    fields = []
+    pos = 0
+    while len(fields) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while end < len(data) and not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    magic, width, height = fields[0], int(fields[1]), int(fields[2])
+    if magic == b"P4":
+        pos += 1
+        stride = (width + 7) // 8
+        return [[(data[pos + y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)] for y in range(height)]
+    if magic == b"P1":
+        bits = [int(c) for c in data[pos:].decode("ascii") if c in "01"]
+        return [bits[y * width:(y + 1) * width] for y in range(height)]
+    sys.exit("%s: 只支持P1/P4格式的PBM" % path)
+
+
+def read_image(path, threshold, invert):
+    """借助Pillow读取GIF/PNG等格式，GIF的每一帧都作为一帧"""
+    try:
+        from PIL import Image, ImageSequence
+    except ImportError:
+        sys.exit("读取%s需要Pillow: pip install pillow" % os.path.basename(path))
+    frames = []
+    for image in ImageSequence.Iterator(Image.open(path)):
+        gray = image.convert("L")
+        width, height = gray.size
+        pixels = gray.load()
+        frames.append([[1 if (pixels[x, y] >= threshold) != invert else 0 for x in range(width)]
+                       for y in range(height)])
+    return frames
+
+
+def pack(rows, width, height):
+    """按页存储: 每页width个字节，低位在上"""
+    data = bytearray()
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and rows[y][x]:
+                    byte |= 1 << bit
+            data.append(byte)
+    return bytes(data)
+
+
+def encode_skip(out, count):
+    while count > 0:
+        n = min(count, MAX_LONG)
+        if n <= MAX_SHORT:
+            out.append(SKIP | (n - 1))
+        else:
+            out += bytes((LONG_SKIP | (n - 1) >> 8, (n - 1) & 0xFF))
+        count -= n
+
+
+def encode_data(out, data):
+    """把一段需要写入的字节编码成重复和原样记号"""
+    i = 0
+    literal = bytearray()
+
+    def flush():
+        for start in range(0, len(literal), MAX_SHORT):
+            chunk = literal[start:start + MAX_SHORT]
+            out.append(LITERAL | (len(chunk) - 1))
+            out.extend(chunk)
+        literal.clear()
+
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < MAX_SHORT:
+            run += 1
+        if run >= MIN_RUN:
+            flush()
+            out += bytes((RUN | (run - 1), data[i]))
+        else:
+            literal += data[i:i + run]
+        i += run
+    flush()
+
+
+def encode_frame(frame, previous, min_skip):
+    """编码一帧，previous为None时编码成关键帧(跳过的字节为0)"""
+    key = previous is None
+    skippable = [(b == 0) if key else (b == previous[i]) for i, b in enumerate(frame)]
+    out = bytearray((KEY_FRAME if key else 0,))
+    i = 0
+    while i < len(frame):
+        start = i
+        while i < len(frame) and skippable[i]:
+            i += 1
+        # 太短的跳过不如并入前后的数据，省掉一次寻址；帧首帧尾的跳过总是保留
+        if i - start >= min_skip or start == 0 or i == len(frame):
+            encode_skip(out, i - start)
+            start = i
+        while i < len(frame):
+            if skippable[i]:
+                end = i
+                while end < len(frame) and skippable[end]:
+                    end += 1
+                if end - i >= min_skip or end == len(frame):
+                    break
+                i = end
+            else:
+                i += 1
+        encode_data(out, frame[start:i])
+    return bytes(out)
+
+
+def emit(name, data, width, height, frames, sources):
+    out = []
+    out.append("/**")
+    out.append(" * @Description %s 由tools/oled_animgen.py从%s生成，请勿手动修改" % (name, sources))
+    out.append(" * @Project OLEDDriver")
+    out.append(" */")
+    out.append('#include "OLEDAnim.h"')
+    out.append("")
+    out.append("static const uint8_t %s_data[%d] = {" % (name, len(data)))
+    for start in range(0, len(data), 16):
+        out.append("    " + ",".join("0x%02X" % b for b in data[start:start + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("const OLED_AnimTypeDef %s = {%s_data, %d, %d, %d, %d};" %
+               (name, name, len(data), width, height, frames))
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="生成OLEDDriver使用的压缩图像/动画")
+    parser.add_argument("inputs", nargs="+", help="PBM(P1/P4)、GIF/PNG等图像，或--raw指定的原始帧文件，按顺序作为各帧")
+    parser.add_argument("--name", required=True, help="生成的OLED_AnimTypeDef变量名")
+    parser.add_argument("--raw", metavar="WxH", help="输入为按页存储的原始帧，依次拼接，例如128x64")
+    parser.add_argument("--key-interval", type=int, default=0, help="每隔多少帧插入一个关键帧，0表示只有第0帧")
+    parser.add_argument("--min-skip", type=int, default=8, help="短于这个长度的跳过并入数据，减少寻址次数")
+    parser.add_argument("--threshold", type=int, default=128, help="Pillow读取时的灰度二值化阈值")
+    parser.add_argument("--invert", action="store_true", help="Pillow读取时暗处点亮")
+    parser.add_argument("-o", "--output", help="输出的.c文件，默认输出到标准输出")
+    args = parser.parse_args()
+
+    frames = []
+    if args.raw:
+        width, height = (int(v) for v in args.raw.lower().split("x"))
+        size = width * ((height + 7) // 8)
+        for path in args.inputs:
+            with open(path, "rb") as f:
+                data = f.read()
+            if len(data) % size:
+                sys.exit("%s: 长度不是%d字节的整数倍" % (path, size))
+            frames += [data[i:i + size] for i in range(0, len(data), size)]
+    else:
+        images = []
+        for path in args.inputs:
+            if path.lower().endswith(".pbm"):
+                images.append(read_pbm(path))
+            else:
+                images += read_image(path, args.threshold, args.invert)
+        height, width = len(images[0]), len(images[0][0])
+        if any(len(rows) != height or len(rows[0]) != width for rows in images):
+            sys.exit("所有帧的尺寸必须相同")
+        frames = [pack(rows, width, height) for rows in images]
+    if not 0 < width <= 255 or not 0 < height <= 255:
+        sys.exit("宽度和高度必须在1~255之间")
+    if len(frames) > 0xFFFF:
+        sys.exit("帧数不能超过65535")
+
+    data = bytearray()
+    previous = None
+    for index, frame in enumerate(frames):
+        if args.key_interval and index % args.key_interval == 0:
+            previous = None
+        data += encode_frame(frame, previous, max(args.min_skip, 1))
+        previous = frame
+    raw = sum(len(frame) for frame in frames)
+    print("%d帧 %dx%d，%d字节压缩到%d字节(%.1f%%)" % (len(frames), width, height, raw, len(data),
+                                                100.0 * len(data) / raw), file=sys.stderr)
+
+    sources = os.path.basename(args.inputs[0]) + ("等%d个文件" % len(args.inputs) if len(args.inputs) > 1 else "")
+    source = emit(args.name, data, width, height, len(frames), sources)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+
+
+if __name__ == "__main__":
+    main()
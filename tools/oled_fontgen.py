@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""
+OLEDDriver字库生成工具
+
+把BDF点阵字体(或借助Pillow把TTF/OTF字体)中用到的字符子集转换成OLEDFont.h中的OLED_FontTypeDef:
+  - 点阵按页存储(每字节一列8个点，低位在上)，与OLED_Draw_Bitmap的格式相同
+  - 字形索引按码点升序排列，运行时二分查找
+  - 每个字形单独记录宽度和前进距离，支持不等宽字体
+  - 所有数据都是const，放在Flash中
+
+用法:
+  python3 oled_fontgen.py wqy12.bdf --name font_cn12 --text strings.txt --range 0x20-0x7e -o font_cn12.c
+  python3 oled_fontgen.py NotoSansSC.otf --size 16 --name font_cn16 --chars "温度湿度" -o font_cn16.c
+"""
+
+import argparse
+import os
+import sys
+
+
+def parse_range(text):
+    """解析 0x20-0x7e 或 0x4e2d 形式的码点范围"""
+    lo, _, hi = text.partition("-")
+    lo = int(lo, 0)
+    return range(lo, (int(hi, 0) if hi else lo) + 1)
+
+
+class Glyph:
+    def __init__(self, code, width, advance, rows):
+        self.code = code
+        self.width = width      # 点阵宽度
+        self.advance = advance  # 前进距离
+        self.rows = rows        # rows[y][x]为0/1，共height行
+
+
+def load_bdf(path, codes, height):
+    """读取BDF字体中需要的字形，按字体的ascent对齐到统一的行高"""
+    glyphs = {}
+    ascent = descent = None
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        key, _, value = line.partition(" ")
+        if key == "FONT_ASCENT":
+            ascent = int(value)
+        elif key == "FONT_DESCENT":
+            descent = int(value)
+        elif key == "FONTBOUNDINGBOX" and ascent is None:
+            _, h, _, yoff = map(int, value.split())
+            ascent, descent = h + yoff, -yoff
+        elif key == "STARTCHAR":
+            code = advance = None
+            bbx = (0, 0, 0, 0)
+            for line in lines:
+                key, _, value = line.partition(" ")
+                if key == "ENCODING":
+                    code = int(value.split()[0])
+                elif key == "DWIDTH":
+                    advance = int(value.split()[0])
+                elif key == "BBX":
+                    bbx = tuple(map(int, value.split()))
+                elif key == "BITMAP":
+                    break
+            bitmap = []
+            for line in lines:
+                if line.startswith("ENDCHAR"):
+                    break
+                bitmap.append(int(line, 16) if line else 0)
+            if code not in codes:
+                continue
+            w, h, xoff, yoff = bbx
+            cell_height = height or ascent + descent
+            width = max(w + max(xoff, 0), 1)
+            rows = [[0] * width for _ in range(cell_height)]
+            top = ascent - (h + yoff)
+            bits = (w + 7) // 8 * 8
+            for j, value in enumerate(bitmap):
+                y = top + j
+                if not 0 <= y < cell_height:
+                    continue
+                for i in range(w):
+                    if value >> (bits - 1 - i) & 1 and 0 <= i + xoff < width:
+                        rows[y][i + xoff] = 1
+            glyphs[code] = Glyph(code, width, advance if advance is not None else width, rows)
+    if ascent is None:
+        sys.exit("%s: 不是有效的BDF字体" % path)
+    return glyphs, height or ascent + descent
+
+
+def load_outline(path, codes, size, height, threshold):
+    """借助Pillow渲染TTF/OTF字体"""
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        sys.exit("渲染TTF/OTF字体需要Pillow: pip install pillow")
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    cell_height = height or ascent + descent
+    glyphs = {}
+    for code in codes:
+        ch = chr(code)
+        if code != 0x20 and font.getmask(ch).getbbox() is None:
+            continue  # 字体中没有这个字
+        advance = max(int(round(font.getlength(ch))), 1)
+        image = Image.new("L", (advance, cell_height), 0)
+        ImageDraw.Draw(image).text((0, 0), ch, font=font, fill=255)
+        rows = [[1 if image.getpixel((x, y)) >= threshold else 0 for x in range(advance)] for y in range(cell_height)]
+        glyphs[code] = Glyph(code, advance, advance, rows)
+    return glyphs, cell_height
+
+
+def pack(glyph, height):
+    """按页存储: 每页width个字节，低位在上"""
+    data = []
+    for page in range((height + 7) // 8):
+        for x in range(glyph.width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and glyph.rows[y][x]:
+                    byte |= 1 << bit
+            data.append(byte)
+    return data
+
+
+def printable(code):
+    return chr(code) if code > 0x20 and chr(code).isprintable() and chr(code) not in "\\" else "U+%04X" % code
+
+
+def emit(name, glyphs, height, fallback, source):
+    out = []
+    out.append("/**")
+    out.append(" * @Description %s 由tools/oled_fontgen.py从%s生成，请勿手动修改" % (name, os.path.basename(source)))
+    out.append(" * @Project OLEDDriver")
+    out.append(" */")
+    out.append('#include "OLEDFont.h"')
+    out.append("")
+    if fallback:
+        out.append("extern const OLED_FontTypeDef %s;" % fallback)
+        out.append("")
+    out.append("static const uint8_t %s_bitmap[] = {" % name)
+    index = []
+    offset = 0
+    for glyph in glyphs:
+        data = pack(glyph, height)
+        index.append((glyph, offset))
+        out.append("    " + ",".join("0x%02X" % b for b in data) + ",  // %s" % printable(glyph.code))
+        offset += len(data)
+    out.append("};")
+    out.append("")
+    out.append("static const OLED_GlyphTypeDef %s_glyphs[%d] = {" % (name, len(glyphs)))
+    for glyph, offset in index:
+        out.append("    {0x%04x, %d, %d, %d},  // %s" % (glyph.code, offset, glyph.width, glyph.advance,
+                                                   printable(glyph.code)))
+    out.append("};")
+    out.append("")
+    out.append("const OLED_FontTypeDef %s = {%s_bitmap, %s_glyphs, %d, 0, 0, %d, %s};" %
+               (name, name, name, len(glyphs), height, "&" + fallback if fallback else "NULL"))
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="生成OLEDDriver使用的字库")
+    parser.add_argument("font", help="BDF/TTF/OTF字体文件")
+    parser.add_argument("--name", required=True, help="生成的OLED_FontTypeDef变量名")
+    parser.add_argument("--chars", default="", help="需要的字符")
+    parser.add_argument("--text", action="append", default=[], help="从UTF-8文本文件中收集需要的字符，可多次指定")
+    parser.add_argument("--range", action="append", default=[], help="码点范围，例如0x20-0x7e，可多次指定")
+    parser.add_argument("--size", type=int, default=16, help="TTF/OTF的字号(像素)")
+    parser.add_argument("--height", type=int, default=0, help="字高，默认使用字体的ascent + descent")
+    parser.add_argument("--threshold", type=int, default=128, help="TTF/OTF灰度二值化阈值")
+    parser.add_argument("--fallback", help="缺字时查找的字库变量名，例如g_oled_font_8x16")
+    parser.add_argument("-o", "--output", help="输出的.c文件，默认输出到标准输出")
+    args = parser.parse_args()
+
+    codes = set(ord(c) for c in args.chars)
+    for path in args.text:
+        with open(path, encoding="utf-8") as f:
+            codes.update(ord(c) for c in f.read() if c not in "\r\n")
+    for text in args.range:
+        codes.update(parse_range(text))
+    if not codes:
+        sys.exit("没有指定字符，使用--chars、--text或--range")
+
+    if args.font.lower().endswith(".bdf"):
+        glyphs, height = load_bdf(args.font, codes, args.height)
+    else:
+        glyphs, height = load_outline(args.font, codes, args.size, args.height, args.threshold)
+    if height > 255:
+        sys.exit("字高不能超过255")
+    missing = sorted(codes - set(glyphs))
+    if missing:
+        print("字体中缺少%d个字符: %s" % (len(missing), " ".join(printable(c) for c in missing[:32])), file=sys.stderr)
+    if any(g.width > 255 or g.advance > 255 for g in glyphs.values()):
+        sys.exit("字宽不能超过255")
+
+    source = emit(args.name, [glyphs[c] for c in sorted(glyphs)], height, args.fallback, args.font)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+
+
+if __name__ == "__main__":
+    main()